@@ -0,0 +1,43 @@
+#ifndef STAN_INTERFACE_CALLBACKS_INTERRUPT_GRADIENT_BUDGET_HPP
+#define STAN_INTERFACE_CALLBACKS_INTERRUPT_GRADIENT_BUDGET_HPP
+
+#include <stan/interface_callbacks/interrupt/base_interrupt.hpp>
+#include <stan/model/counting_model.hpp>
+
+namespace stan {
+  namespace interface_callbacks {
+    namespace interrupt {
+
+      /**
+       * Interrupt that stops a service once the gradient budget of
+       * a counting_model is exhausted, by throwing
+       * stan::model::gradient_budget_exhausted before the next
+       * iteration.  The sampling services catch it and end the
+       * phase with the draws written so far, and the BFGS
+       * optimizer ends with an error at its last iterate.
+       * Iterations are never cut short, so the budget may be
+       * exceeded by up to one iteration's worth of gradients.
+       *
+       * @tparam M Class of the wrapped model.
+       */
+      template <class M>
+      class gradient_budget: public base_interrupt {
+      public:
+        explicit gradient_budget(const stan::model::counting_model<M>& model)
+          : model_(model) {}
+
+        void operator()() {
+          if (model_.budget_exhausted())
+            throw stan::model::gradient_budget_exhausted(
+              model_.num_gradients());
+        }
+
+      private:
+        const stan::model::counting_model<M>& model_;
+      };
+
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef STAN_INTERFACE_CALLBACKS_WRITER_DUMP_WRITER_HPP
+#define STAN_INTERFACE_CALLBACKS_WRITER_DUMP_WRITER_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace interface_callbacks {
+    namespace writer {
+
+      /**
+       * dump_writer writes numeric key-value pairs to an
+       * std::ostream in the R dump format read by stan::io::dump.
+       *
+       * Values are written with enough digits to be read back
+       * exactly.  Matrices, given in row-major order, are written
+       * in column-major order with their dimensions.  Names,
+       * unnamed values, and messages have no dump representation
+       * and are ignored.
+       */
+      class dump_writer : public base_writer {
+      public:
+        /**
+         * Constructor.
+         *
+         * @param output std::ostream to write to
+         */
+        explicit dump_writer(std::ostream& output)
+          : output__(output) {
+          output__.precision(std::numeric_limits<double>::digits10 + 2);
+        }
+
+        void operator()(const std::string& key, double value) {
+          output__ << key << " <- " << value << std::endl;
+        }
+
+        void operator()(const std::string& key, int value) {
+          output__ << key << " <- " << value << std::endl;
+        }
+
+        void operator()(const std::string& key, const std::string& value) {}
+
+        void operator()(const std::string& key,
+                        const double* values,
+                        int n_values) {
+          output__ << key << " <- c(";
+          for (int n = 0; n < n_values; ++n)
+            output__ << (n > 0 ? ", " : "") << values[n];
+          output__ << ")" << std::endl;
+        }
+
+        void operator()(const std::string& key,
+                        const double* values,
+                        int n_rows, int n_cols) {
+          output__ << key << " <- structure(c(";
+          for (int j = 0; j < n_cols; ++j)
+            for (int i = 0; i < n_rows; ++i)
+              output__ << (i + j > 0 ? ", " : "") << values[i * n_cols + j];
+          output__ << "), .Dim = c(" << n_rows << ", " << n_cols << "))"
+                   << std::endl;
+        }
+
+        void operator()(const std::vector<std::string>& names) {}
+
+        void operator()(const std::vector<double>& state) {}
+
+        void operator()() {}
+
+        void operator()(const std::string& message) {}
+
+      private:
+        std::ostream& output__;
+      };
+
+    }
+  }
+}
+
+#endif
@@ -1,6 +1,10 @@
 #ifndef STAN_MCMC_BASE_ADAPTER_HPP
 #define STAN_MCMC_BASE_ADAPTER_HPP
 
+#include <stan/mcmc/chain_state.hpp>
+#include <istream>
+#include <ostream>
+
 namespace stan {
   namespace mcmc {
 
@@ -9,6 +13,8 @@ namespace stan {
       base_adapter()
         : adapt_flag_(false) {}
 
+      virtual ~base_adapter() {}
+
       virtual void engage_adaptation() {
         adapt_flag_ = true;
       }
@@ -21,6 +27,18 @@ namespace stan {
         return adapt_flag_;
       }
 
+      /**
+       * Saves the state of every adaptation, to be restored by
+       * read_adaptation_state() on an adapter configured the same.
+       */
+      virtual void write_adaptation_state(std::ostream& o) {
+        write_chain_state(o, adapt_flag_);
+      }
+
+      virtual void read_adaptation_state(std::istream& in) {
+        read_chain_state_value(in, adapt_flag_);
+      }
+
     protected:
       bool adapt_flag_;
     };
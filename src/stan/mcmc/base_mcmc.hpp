@@ -3,6 +3,8 @@
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
 #include <stan/mcmc/sample.hpp>
+#include <stan/mcmc/transition_profile.hpp>
+#include <istream>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -28,11 +30,35 @@ namespace stan {
       virtual void
       write_sampler_state(interface_callbacks::writer::base_writer& writer) {}
 
+      /**
+       * Writes the adapted parameters of the sampler as key-value
+       * pairs that can be loaded to start a later run.
+       */
+      virtual void
+      write_adapted_params(interface_callbacks::writer::base_writer& writer) {}
+
       virtual void
       get_sampler_diagnostic_names(std::vector<std::string>& model_names,
                                    std::vector<std::string>& names) {}
 
       virtual void get_sampler_diagnostics(std::vector<double>& values) {}
+
+      /**
+       * Attaches a profile that samplers supporting it fill with
+       * the timing of their transitions, or detaches it when 0.
+       */
+      virtual void set_profile(transition_profile* profile) {}
+
+      /**
+       * Saves the state of the sampler that persists between
+       * transitions, such as the current point and step size, so
+       * read_state() on a sampler configured the same continues the
+       * chain exactly.  The state of adaptation is saved separately
+       * by samplers that are also adapters.
+       */
+      virtual void write_state(std::ostream& o) {}
+
+      virtual void read_state(std::istream& in) {}
     };
 
   }  // mcmc
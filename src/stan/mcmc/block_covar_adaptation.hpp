@@ -0,0 +1,122 @@
+#ifndef STAN_MCMC_BLOCK_COVAR_ADAPTATION_HPP
+#define STAN_MCMC_BLOCK_COVAR_ADAPTATION_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/mcmc/chain_state.hpp>
+#include <stan/mcmc/windowed_adaptation.hpp>
+#include <cmath>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+
+  namespace mcmc {
+
+    /**
+     * Adapts a block-diagonal inverse metric with one Welford
+     * covariance estimator per block of consecutive parameters,
+     * regularized as in covar_adaptation.
+     */
+    class block_covar_adaptation: public windowed_adaptation {
+    public:
+      explicit block_covar_adaptation(int n)
+        : windowed_adaptation("block covariance") {
+        set_blocks(std::vector<int>(n, 1));
+      }
+
+      void set_blocks(const std::vector<int>& sizes) {
+        block_sizes_ = sizes;
+        estimators_.clear();
+        for (size_t b = 0; b < sizes.size(); ++b)
+          estimators_.push_back(restorable_covar_estimator(sizes[b]));
+      }
+
+      const std::vector<int>& block_sizes() const {
+        return block_sizes_;
+      }
+
+      bool learn_covariance(std::vector<Eigen::MatrixXd>& covar,
+                            const Eigen::VectorXd& q) {
+        if (adaptation_window()) {
+          int start = 0;
+          for (size_t b = 0; b < estimators_.size(); ++b) {
+            estimators_[b].add_sample(q.segment(start, block_sizes_[b]));
+            start += block_sizes_[b];
+          }
+        }
+
+        if (end_adaptation_window()) {
+          compute_next_window();
+
+          double diff_sq = 0;
+          double previous_sq = 0;
+          bool same_blocks = covar.size() == estimators_.size();
+
+          covar.resize(estimators_.size());
+          for (size_t b = 0; b < estimators_.size(); ++b) {
+            int n_b = block_sizes_[b];
+            Eigen::MatrixXd previous = covar[b];
+            same_blocks = same_blocks && previous.rows() == n_b;
+            covar[b].resize(n_b, n_b);
+            estimators_[b].sample_covariance(covar[b]);
+
+            double n = static_cast<double>(estimators_[b].num_samples());
+            covar[b] = (n / (n + 5.0)) * covar[b]
+              + 1e-3 * (5.0 / (n + 5.0))
+              * Eigen::MatrixXd::Identity(n_b, n_b);
+
+            if (same_blocks) {
+              diff_sq += (covar[b] - previous).squaredNorm();
+              previous_sq += previous.squaredNorm();
+            }
+
+            estimators_[b].restart();
+          }
+
+          if (same_blocks)
+            record_window_change_(std::sqrt(diff_sq), std::sqrt(previous_sq));
+          else
+            record_window_change_(0, 0);
+
+          ++adapt_window_counter_;
+          return true;
+        }
+
+        ++adapt_window_counter_;
+        return false;
+      }
+
+      /**
+       * Saves the window counters and the estimator of each block.
+       * The block partition is part of the configuration and must
+       * be set before read_state().
+       */
+      void write_state(std::ostream& o) {
+        windowed_adaptation::write_state(o);
+        o << estimators_.size() << ' ';
+        for (size_t b = 0; b < estimators_.size(); ++b)
+          estimators_[b].write_state(o);
+      }
+
+      void read_state(std::istream& in) {
+        windowed_adaptation::read_state(in);
+        size_t num_blocks = 0;
+        if (!(in >> num_blocks) || num_blocks != estimators_.size())
+          throw std::domain_error("Chain state does not match the metric "
+                                  "blocks");
+        for (size_t b = 0; b < estimators_.size(); ++b)
+          estimators_[b].read_state(in);
+      }
+
+    protected:
+      std::vector<int> block_sizes_;
+      std::vector<restorable_covar_estimator> estimators_;
+    };
+
+  }  // mcmc
+
+}  // stan
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef STAN_MCMC_CHAIN_STATE_HPP
+#define STAN_MCMC_CHAIN_STATE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/welford_var_estimator.hpp>
+#include <stan/math/prim/mat/fun/welford_covar_estimator.hpp>
+#include <cstdlib>
+#include <deque>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Writes a value of the state of a chain as whitespace separated
+     * text.  Doubles are written with enough significant digits to
+     * be read back exactly, and vectors and matrices are preceded by
+     * their dimensions.
+     */
+    inline void write_chain_state(std::ostream& o, double x) {
+      std::streamsize precision = o.precision();
+      o.precision(std::numeric_limits<double>::digits10 + 2);
+      o << x << ' ';
+      o.precision(precision);
+    }
+
+    inline void write_chain_state(std::ostream& o, const Eigen::VectorXd& x) {
+      o << x.size() << ' ';
+      for (int i = 0; i < x.size(); ++i)
+        write_chain_state(o, x(i));
+    }
+
+    inline void write_chain_state(std::ostream& o, const Eigen::MatrixXd& x) {
+      o << x.rows() << ' ' << x.cols() << ' ';
+      for (int i = 0; i < x.size(); ++i)
+        write_chain_state(o, x(i));
+    }
+
+    inline void write_chain_state(std::ostream& o,
+                                  const std::deque<double>& x) {
+      o << x.size() << ' ';
+      for (size_t i = 0; i < x.size(); ++i)
+        write_chain_state(o, x[i]);
+    }
+
+    // Parsed with strtod, which unlike operator>> reads back the
+    // inf and nan written for non-finite values
+    inline void read_chain_state(std::istream& in, double& x) {
+      std::string token;
+      char* end = 0;
+      if (in >> token)
+        x = std::strtod(token.c_str(), &end);
+      if (end == 0 || *end != '\0')
+        throw std::domain_error("Chain state is truncated or corrupt");
+    }
+
+    inline void read_chain_state(std::istream& in, Eigen::VectorXd& x) {
+      int n = 0;
+      if (!(in >> n) || n < 0)
+        throw std::domain_error("Chain state is truncated or corrupt");
+      x.resize(n);
+      for (int i = 0; i < n; ++i)
+        read_chain_state(in, x(i));
+    }
+
+    inline void read_chain_state(std::istream& in, Eigen::MatrixXd& x) {
+      int rows = 0;
+      int cols = 0;
+      if (!(in >> rows >> cols) || rows < 0 || cols < 0)
+        throw std::domain_error("Chain state is truncated or corrupt");
+      x.resize(rows, cols);
+      for (int i = 0; i < x.size(); ++i)
+        read_chain_state(in, x(i));
+    }
+
+    inline void read_chain_state(std::istream& in, std::deque<double>& x) {
+      int n = 0;
+      if (!(in >> n) || n < 0)
+        throw std::domain_error("Chain state is truncated or corrupt");
+      x.resize(n);
+      for (int i = 0; i < n; ++i)
+        read_chain_state(in, x[i]);
+    }
+
+    /**
+     * Reads a vector whose size must match the expected size, so a
+     * state saved for a different model fails to restore.
+     */
+    inline void read_chain_state(std::istream& in, Eigen::VectorXd& x,
+                                 int expected_size) {
+      read_chain_state(in, x);
+      if (x.size() != expected_size)
+        throw std::domain_error("Chain state does not match the number "
+                                "of parameters");
+    }
+
+    /**
+     * Reads a counter or flag written as a double.
+     */
+    template <typename T>
+    void read_chain_state_value(std::istream& in, T& x) {
+      double y;
+      read_chain_state(in, y);
+      x = static_cast<T>(y);
+    }
+
+    /**
+     * Welford variance estimator whose running statistics can be
+     * saved and restored.
+     */
+    class restorable_var_estimator
+      : public stan::math::welford_var_estimator {
+    public:
+      explicit restorable_var_estimator(int n)
+        : stan::math::welford_var_estimator(n) {}
+
+      void write_state(std::ostream& o) {
+        write_chain_state(o, static_cast<double>(num_samples_));
+        write_chain_state(o, m_);
+        write_chain_state(o, m2_);
+      }
+
+      void read_state(std::istream& in) {
+        read_chain_state_value(in, num_samples_);
+        read_chain_state(in, m_, m_.size());
+        read_chain_state(in, m2_, m2_.size());
+      }
+    };
+
+    /**
+     * Welford covariance estimator whose running statistics can be
+     * saved and restored.
+     */
+    class restorable_covar_estimator
+      : public stan::math::welford_covar_estimator {
+    public:
+      explicit restorable_covar_estimator(int n)
+        : stan::math::welford_covar_estimator(n) {}
+
+      void write_state(std::ostream& o) {
+        write_chain_state(o, static_cast<double>(num_samples_));
+        write_chain_state(o, m_);
+        write_chain_state(o, m2_);
+      }
+
+      void read_state(std::istream& in) {
+        int n = m_.size();
+        read_chain_state_value(in, num_samples_);
+        read_chain_state(in, m_, n);
+        read_chain_state(in, m2_);
+        if (m2_.rows() != n || m2_.cols() != n)
+          throw std::domain_error("Chain state does not match the number "
+                                  "of parameters");
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
@@ -2,8 +2,12 @@
 #define STAN_MCMC_COVAR_ADAPTATION_HPP
 
 #include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/mcmc/chain_state.hpp>
 #include <stan/mcmc/windowed_adaptation.hpp>
-#include <stan/math/prim/mat/fun/welford_covar_estimator.hpp>
+#include <Eigen/Cholesky>
+#include <cmath>
+#include <istream>
+#include <ostream>
 #include <vector>
 
 namespace stan {
@@ -13,23 +17,79 @@ namespace stan {
     class covar_adaptation: public windowed_adaptation {
     public:
       explicit covar_adaptation(int n)
-        : windowed_adaptation("covariance"), estimator_(n) {}
+        : windowed_adaptation("covariance"), estimator_(n),
+          restart_pending_(false), streaming_(false), factor_valid_(false),
+          window_samples_(0), factor_scale_(0) {}
+
+      /**
+       * Maintains the Cholesky factor of the regularized covariance
+       * with a rank-one update per draw, so the end of a window
+       * costs O(D^2) instead of an O(D^3) factorization.  Each draw
+       * costs an extra O(D^2).  Pooled adaptation always factors at
+       * the end of the window.
+       */
+      void set_streaming(bool streaming) {
+        streaming_ = streaming;
+      }
+
+      bool streaming() {
+        return streaming_;
+      }
+
+      /**
+       * Pools the covariance estimate with other chains that advance
+       * in lockstep with this one and share its window parameters;
+       * see var_adaptation::set_pool.
+       *
+       * @param pool Adaptations of all chains, including this one;
+       *   a pool of fewer than two chains restores single chain
+       *   adaptation
+       */
+      void set_pool(const std::vector<covar_adaptation*>& pool) {
+        pool_ = pool;
+      }
 
       bool learn_covariance(Eigen::MatrixXd& covar, const Eigen::VectorXd& q) {
-        if (adaptation_window())
+        if (restart_pending_) {
+          estimator_.restart();
+          restart_pending_ = false;
+        }
+
+        bool pooled = pool_.size() > 1;
+
+        if (adaptation_window() && !(pooled && end_adaptation_window())) {
+          if (streaming_ && !pooled)
+            update_factor_(q);
           estimator_.add_sample(q);
+        }
 
         if (end_adaptation_window()) {
           compute_next_window();
+          Eigen::MatrixXd previous = covar;
 
-          estimator_.sample_covariance(covar);
+          double n = 0;
+          if (pooled) {
+            n = pooled_covariance(covar);
+          } else {
+            estimator_.sample_covariance(covar);
+            n = static_cast<double>(estimator_.num_samples());
+          }
 
-          double n = static_cast<double>(estimator_.num_samples());
           covar = (n / (n + 5.0)) * covar
             + 1e-3 * (5.0 / (n + 5.0))
             * Eigen::MatrixXd::Identity(covar.rows(), covar.cols());
+          record_window_change_((covar - previous).norm(), previous.norm());
 
-          estimator_.restart();
+          factor_valid_ = streaming_ && !pooled && window_samples_ > 1
+                          && window_samples_
+                             == static_cast<unsigned int>(
+                                  estimator_.num_samples());
+          window_samples_ = 0;
+
+          if (pooled)
+            restart_pending_ = true;
+          else
+            estimator_.restart();
 
           ++adapt_window_counter_;
           return true;
@@ -39,8 +99,148 @@ namespace stan {
         return false;
       }
 
+      /**
+       * Learns the covariance together with its lower Cholesky
+       * factor, which comes from the rank-one updates in streaming
+       * mode and from a factorization otherwise.
+       */
+      bool learn_covariance(Eigen::MatrixXd& covar,
+                            Eigen::MatrixXd& covar_L,
+                            const Eigen::VectorXd& q) {
+        if (!learn_covariance(covar, q))
+          return false;
+
+        if (factor_valid_)
+          covar_L = factor_;
+        else
+          covar_L = covar.llt().matrixL();
+        return true;
+      }
+
+      void write_state(std::ostream& o) {
+        windowed_adaptation::write_state(o);
+        estimator_.write_state(o);
+        write_chain_state(o, restart_pending_);
+        write_chain_state(o, factor_valid_);
+        write_chain_state(o, window_samples_);
+        write_chain_state(o, factor_scale_);
+        write_chain_state(o, factor_);
+      }
+
+      void read_state(std::istream& in) {
+        windowed_adaptation::read_state(in);
+        estimator_.read_state(in);
+        read_chain_state_value(in, restart_pending_);
+        read_chain_state_value(in, factor_valid_);
+        read_chain_state_value(in, window_samples_);
+        read_chain_state(in, factor_scale_);
+        read_chain_state(in, factor_);
+      }
+
     protected:
-      stan::math::welford_covar_estimator estimator_;
+      restorable_covar_estimator estimator_;
+      std::vector<covar_adaptation*> pool_;
+      bool restart_pending_;
+
+      bool streaming_;
+      bool factor_valid_;
+      unsigned int window_samples_;
+      double factor_scale_;
+      Eigen::MatrixXd factor_;
+      Eigen::VectorXd mean_;
+      Eigen::VectorXd w_;
+
+      /**
+       * Folds the next draw into the Cholesky factor of the
+       * regularized covariance at the end of the current window,
+       *
+       *   a M2 + b I,  a = n / ((n + 5) (n - 1)),  b = 5e-3 / (n + 5),
+       *
+       * where n, the number of draws in the window, is known once
+       * the window starts.  Each draw adds a rank-one term to the
+       * Welford sum of squares M2.
+       */
+      void update_factor_(const Eigen::VectorXd& q) {
+        double n_old = estimator_.num_samples();
+
+        if (n_old == 0) {
+          window_samples_ = adapt_next_window_ - adapt_window_counter_ + 1;
+          double n = window_samples_;
+          if (n < 2)
+            return;
+          factor_scale_ = n / ((n + 5.0) * (n - 1.0));
+          factor_ = std::sqrt(5e-3 / (n + 5.0))
+                    * Eigen::MatrixXd::Identity(q.size(), q.size());
+          return;
+        }
+
+        if (window_samples_ < 2)
+          return;
+
+        estimator_.sample_mean(mean_);
+        w_ = std::sqrt(factor_scale_ * n_old / (n_old + 1)) * (q - mean_);
+        rank_one_update_(factor_, w_);
+      }
+
+      /**
+       * Replaces the lower Cholesky factor L of A by that of
+       * A + w w^T in O(D^2), overwriting w.
+       */
+      static void rank_one_update_(Eigen::MatrixXd& L, Eigen::VectorXd& w) {
+        const int D = L.rows();
+        for (int k = 0; k < D; ++k) {
+          double r = std::sqrt(L(k, k) * L(k, k) + w(k) * w(k));
+          double c = r / L(k, k);
+          double s = w(k) / L(k, k);
+          L(k, k) = r;
+
+          const int m = D - k - 1;
+          if (m == 0)
+            break;
+          L.col(k).tail(m) = (L.col(k).tail(m) + s * w.tail(m)) / c;
+          w.tail(m) = c * w.tail(m) - s * L.col(k).tail(m);
+        }
+      }
+
+      /**
+       * Combines the Welford statistics of every chain in the pool.
+       *
+       * @param[out] covar Pooled sample covariance
+       * @return Pooled number of samples
+       */
+      double pooled_covariance(Eigen::MatrixXd& covar) {
+        double n = 0;
+        Eigen::VectorXd mean = Eigen::VectorXd::Zero(covar.rows());
+        Eigen::VectorXd chain_mean(covar.rows());
+
+        for (size_t c = 0; c < pool_.size(); ++c) {
+          double n_c = pool_[c]->estimator_.num_samples();
+          if (n_c == 0) continue;
+          pool_[c]->estimator_.sample_mean(chain_mean);
+          n += n_c;
+          mean += (n_c / n) * (chain_mean - mean);
+        }
+
+        if (n < 2) return n;
+
+        Eigen::MatrixXd m2 = Eigen::MatrixXd::Zero(covar.rows(), covar.cols());
+        Eigen::MatrixXd chain_covar(covar.rows(), covar.cols());
+
+        for (size_t c = 0; c < pool_.size(); ++c) {
+          double n_c = pool_[c]->estimator_.num_samples();
+          if (n_c == 0) continue;
+          pool_[c]->estimator_.sample_mean(chain_mean);
+          if (n_c > 1) {
+            pool_[c]->estimator_.sample_covariance(chain_covar);
+            m2 += (n_c - 1) * chain_covar;
+          }
+          chain_mean -= mean;
+          m2 += n_c * chain_mean * chain_mean.transpose();
+        }
+
+        covar = m2 / (n - 1.0);
+        return n;
+      }
     };
 
   }  // mcmc
@@ -3,12 +3,16 @@
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
 #include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/chain_state.hpp>
 #include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
+#include <stan/mcmc/hmc/integrators/integrator_scheme.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <boost/random/uniform_01.hpp>
 #include <cmath>
+#include <istream>
 #include <limits>
+#include <ostream>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -31,7 +35,14 @@ namespace stan {
           rand_uniform_(rand_int_),
           nom_epsilon_(0.1),
           epsilon_(nom_epsilon_),
-          epsilon_jitter_(0.0) {}
+          epsilon_jitter_(0.0),
+          init_stepsize_stride_(1),
+          profile_(0) {}
+
+      void set_profile(transition_profile* profile) {
+        profile_ = profile;
+        hamiltonian_.set_profile(profile);
+      }
 
       void
       write_sampler_state(interface_callbacks::writer::base_writer& writer) {
@@ -41,6 +52,12 @@ namespace stan {
         z_.write_metric(writer);
       }
 
+      void
+      write_adapted_params(interface_callbacks::writer::base_writer& writer) {
+        writer("stepsize", get_nominal_stepsize());
+        z_.write_inv_metric(writer);
+      }
+
       void get_sampler_diagnostic_names(std::vector<std::string>& model_names,
                                         std::vector<std::string>& names) {
         z_.get_param_names(model_names, names);
@@ -50,8 +67,21 @@ namespace stan {
         z_.get_params(values);
       }
 
+      void write_state(std::ostream& o) {
+        z_.write_state(o);
+        write_chain_state(o, nom_epsilon_);
+        write_chain_state(o, epsilon_);
+      }
+
+      void read_state(std::istream& in) {
+        z_.read_state(in);
+        read_chain_state(in, nom_epsilon_);
+        read_chain_state(in, epsilon_);
+      }
+
       void seed(const Eigen::VectorXd& q) {
         z_.q = q;
+        z_.invalidate_kinetic();
       }
 
       void
@@ -60,6 +90,24 @@ namespace stan {
         this->hamiltonian_.init(this->z_, info_writer, error_writer);
       }
 
+      /**
+       * Finds an initial step size for which a single integrator
+       * step from the current point has an acceptance probability
+       * near 0.8.
+       *
+       * Starting from the nominal step size, the step size is
+       * scaled by 2^stride until the acceptance criterion flips,
+       * then the exponents of 2 in the last interval are bisected.
+       * The search brackets the same acceptance crossing as
+       * doubling or halving one step at a time, which a stride of 1
+       * does, and bisects within it, so where the acceptance
+       * probability is not monotone in the step size it can return a
+       * different step size.  A start d doublings away needs about
+       * d / stride + log2(stride) probes instead of d.  A stride that
+       * would step past 1e7, or to zero, is shortened to the last
+       * step size doubling or halving would probe, so the search only
+       * fails where they do.
+       */
       void
       init_stepsize(interface_callbacks::writer::base_writer& info_writer,
                     interface_callbacks::writer::base_writer& error_writer) {
@@ -69,68 +117,88 @@ namespace stan {
         if (this->nom_epsilon_ == 0 || this->nom_epsilon_ > 1e7)
           return;
 
-        this->hamiltonian_.sample_p(this->z_, this->rand_int_);
-        this->hamiltonian_.init(this->z_, info_writer, error_writer);
-
-        // Guaranteed to be finite if randomly initialized
-        double H0 = this->hamiltonian_.H(this->z_);
+        int direction
+          = stepsize_delta_H_(z_init, info_writer, error_writer)
+            > std::log(0.8) ? 1 : -1;
 
-        this->integrator_.evolve(this->z_, this->hamiltonian_,
-                                 this->nom_epsilon_,
-                                 info_writer, error_writer);
-
-        double h = this->hamiltonian_.H(this->z_);
-        if (boost::math::isnan(h))
-          h = std::numeric_limits<double>::infinity();
-
-        double delta_H = H0 - h;
-
-        int direction = delta_H > std::log(0.8) ? 1 : -1;
+        // Last probed step size on the starting side of the
+        // criterion, once one has been found, and the exponent of 2
+        // from it to the next probe
+        double unflipped = 0;
+        int stride = 0;
 
         while (1) {
-          this->z_.ps_point::operator=(z_init);
-
-          this->hamiltonian_.sample_p(this->z_, this->rand_int_);
-          this->hamiltonian_.init(this->z_, info_writer, error_writer);
-
-          double H0 = this->hamiltonian_.H(this->z_);
-
-          this->integrator_.evolve(this->z_, this->hamiltonian_,
-                                   this->nom_epsilon_,
-                                   info_writer, error_writer);
-
-          double h = this->hamiltonian_.H(this->z_);
-          if (boost::math::isnan(h))
-            h = std::numeric_limits<double>::infinity();
-
-          double delta_H = H0 - h;
+          double delta_H
+            = stepsize_delta_H_(z_init, info_writer, error_writer);
 
           if ((direction == 1) && !(delta_H > std::log(0.8)))
             break;
           else if ((direction == -1) && !(delta_H < std::log(0.8)))
             break;
-          else
-            this->nom_epsilon_
-              = direction == 1
-              ? 2.0 * this->nom_epsilon_
-              : 0.5 * this->nom_epsilon_;
 
-          if (this->nom_epsilon_ > 1e7)
+          unflipped = this->nom_epsilon_;
+          stride = this->init_stepsize_stride_;
+          double next = 0;
+          for (; stride > 0; --stride) {
+            next = unflipped * std::pow(2.0, direction * stride);
+            if (next <= 1e7 && next > 0)
+              break;
+          }
+
+          if (stride == 0 && direction == 1)
             throw std::runtime_error("Posterior is improper. "
                                      "Please check your model.");
-          if (this->nom_epsilon_ == 0)
+          if (stride == 0)
             throw std::runtime_error("No acceptably small step size could "
                                      "be found. Perhaps the posterior is "
                                      "not continuous?");
+          this->nom_epsilon_ = next;
+        }
+
+        // Bisect the exponents of 2 between the last step size on
+        // the starting side and the first across the criterion
+        if (unflipped > 0) {
+          int lower = 0;
+          int upper = stride;
+          while (upper - lower > 1) {
+            int middle = (lower + upper) / 2;
+            this->nom_epsilon_
+              = unflipped * std::pow(2.0, direction * middle);
+            double delta_H
+              = stepsize_delta_H_(z_init, info_writer, error_writer);
+            if ((direction == 1) ? !(delta_H > std::log(0.8))
+                                 : !(delta_H < std::log(0.8)))
+              upper = middle;
+            else
+              lower = middle;
+          }
+          this->nom_epsilon_ = unflipped * std::pow(2.0, direction * upper);
         }
 
         this->z_.ps_point::operator=(z_init);
       }
 
+      /**
+       * Sets the log2 ratio between successive step sizes probed by
+       * init_stepsize() while bracketing the acceptance criterion.
+       */
+      void set_init_stepsize_stride(int stride) {
+        if (stride > 0)
+          init_stepsize_stride_ = stride;
+      }
+
+      int get_init_stepsize_stride() {
+        return this->init_stepsize_stride_;
+      }
+
       typename Hamiltonian<Model, BaseRNG>::PointType& z() {
         return z_;
       }
 
+      Integrator<Hamiltonian<Model, BaseRNG> >& integrator() {
+        return integrator_;
+      }
+
       virtual void set_nominal_stepsize(double e) {
         if (e > 0)
           nom_epsilon_ = e;
@@ -153,6 +221,23 @@ namespace stan {
         return this->epsilon_jitter_;
       }
 
+      /**
+       * Selects the splitting scheme of each integrator step.  Schemes
+       * with more stages take more gradients per step but have lower
+       * energy error, so step size adaptation picks larger steps.
+       */
+      void set_integrator_scheme(integrator_scheme scheme) {
+        this->integrator_.set_scheme(scheme);
+      }
+
+      integrator_scheme get_integrator_scheme() {
+        return this->integrator_.get_scheme();
+      }
+
+      void set_adaptive_threshold_scale(double c) {
+        this->integrator_.set_adaptive_threshold_scale(c);
+      }
+
       void sample_stepsize() {
         this->epsilon_ = this->nom_epsilon_;
         if (this->epsilon_jitter_)
@@ -173,6 +258,41 @@ namespace stan {
       double nom_epsilon_;
       double epsilon_;
       double epsilon_jitter_;
+      int init_stepsize_stride_;
+
+      transition_profile* profile_;
+
+      // Energy change of one integrator step of the nominal step
+      // size from z_init with a new momentum
+      double stepsize_delta_H_(
+        const ps_point& z_init,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        this->z_.ps_point::operator=(z_init);
+
+        this->sample_momentum_();
+        this->hamiltonian_.init(this->z_, info_writer, error_writer);
+
+        // Guaranteed to be finite if randomly initialized
+        double H0 = this->hamiltonian_.H(this->z_);
+
+        this->integrator_.evolve(this->z_, this->hamiltonian_,
+                                 this->nom_epsilon_,
+                                 info_writer, error_writer);
+
+        double h = this->hamiltonian_.H(this->z_);
+        if (boost::math::isnan(h))
+          h = std::numeric_limits<double>::infinity();
+
+        return H0 - h;
+      }
+
+      // Draws a new momentum for z_, timed as the RNG phase
+      void sample_momentum_() {
+        if (profile_) profile_->begin(transition_profile::rng_phase);
+        this->hamiltonian_.sample_p(this->z_, this->rand_int_);
+        if (profile_) profile_->end(transition_profile::rng_phase);
+      }
     };
 
   }  // mcmc
@@ -3,6 +3,8 @@
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/mcmc/transition_profile.hpp>
+#include <stan/model/gradient_arena.hpp>
 #include <stan/model/util.hpp>
 #include <iostream>
 #include <limits>
@@ -16,7 +18,7 @@ namespace stan {
     class base_hamiltonian {
     public:
       explicit base_hamiltonian(const Model& model)
-        : model_(model) {}
+        : model_(model), profile_(0) {}
 
       ~base_hamiltonian() {}
 
@@ -36,6 +38,41 @@ namespace stan {
         return T(z) + V(z);
       }
 
+      /**
+       * Evaluates the kinetic energy tau and the velocity dtau/dp
+       * together and caches both on the point, where they stay
+       * valid until the point is next modified.
+       *
+       * @param z Point in phase space
+       */
+      void update_kinetic(Point& z) {
+        if (z.kinetic_cached)
+          return;
+        if (profile_) profile_->begin(transition_profile::kinetic_phase);
+        compute_kinetic(z);
+        if (profile_) profile_->end(transition_profile::kinetic_phase);
+        z.kinetic_cached = true;
+      }
+
+      /**
+       * Hamiltonian H = tau + phi using the cached kinetic terms,
+       * leaving the velocity dtau/dp available in z.p_sharp.
+       *
+       * @param z Point in phase space
+       * @return Hamiltonian at z
+       */
+      double H_cached(Point& z) {
+        update_kinetic(z);
+        return z.tau + phi(z);
+      }
+
+      // Fills z.tau and z.p_sharp; metrics override this to share
+      // the metric product between the two
+      virtual void compute_kinetic(Point& z) {
+        z.p_sharp = dtau_dp(z);
+        z.tau = tau(z);
+      }
+
       // The time derivative of the virial, G = \sum_{d = 1}^{D} q^{d} p_{d}.
       virtual double dG_dt(
         Point& z,
@@ -80,14 +117,16 @@ namespace stan {
         Point& z,
         interface_callbacks::writer::base_writer& info_writer,
         interface_callbacks::writer::base_writer& error_writer) {
+        if (profile_) profile_->begin(transition_profile::gradient_phase);
         try {
-          stan::model::gradient(model_, z.q, z.V, z.g, info_writer);
+          arena_.gradient(model_, z.q, z.V, z.g, info_writer);
           z.V = -z.V;
         } catch (const std::exception& e) {
           this->write_error_msg_(e, error_writer);
           z.V = std::numeric_limits<double>::infinity();
         }
         z.g = -z.g;
+        if (profile_) profile_->end(transition_profile::gradient_phase);
       }
 
       void update_metric(
@@ -107,8 +146,26 @@ namespace stan {
         update_potential_gradient(z, info_writer, error_writer);
       }
 
+      /**
+       * Autodiff tape statistics of the potential gradients
+       * evaluated by this Hamiltonian.
+       */
+      const stan::model::gradient_arena& get_gradient_arena() const {
+        return arena_;
+      }
+
+      void set_profile(transition_profile* profile) {
+        profile_ = profile;
+      }
+
+      transition_profile* get_profile() {
+        return profile_;
+      }
+
     protected:
       const Model& model_;
+      stan::model::gradient_arena arena_;
+      transition_profile* profile_;
 
       void write_error_msg_(const std::exception& e,
                             interface_callbacks::writer::base_writer& writer) {
@@ -0,0 +1,96 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_BLOCK_DENSE_E_METRIC_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_BLOCK_DENSE_E_METRIC_HPP
+
+#include <stan/mcmc/hmc/hamiltonians/base_hamiltonian.hpp>
+#include <stan/mcmc/hmc/hamiltonians/block_dense_e_point.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/random/normal_distribution.hpp>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Euclidean manifold with block-diagonal metric, dense within
+     * each block.  Memory and cost per step scale with the sum of
+     * the squared block sizes.
+     */
+    template <class Model, class BaseRNG>
+    class block_dense_e_metric
+      : public base_hamiltonian<Model, block_dense_e_point, BaseRNG> {
+    public:
+      explicit block_dense_e_metric(const Model& model)
+        : base_hamiltonian<Model, block_dense_e_point, BaseRNG>(model) {}
+
+      double T(block_dense_e_point& z) {
+        return 0.5 * z.p.dot(dtau_dp(z));
+      }
+
+      double tau(block_dense_e_point& z) {
+        return T(z);
+      }
+
+      double phi(block_dense_e_point& z) {
+        return this->V(z);
+      }
+
+      double dG_dt(block_dense_e_point& z,
+                   interface_callbacks::writer::base_writer& info_writer,
+                   interface_callbacks::writer::base_writer& error_writer) {
+        return 2 * T(z) - z.q.dot(z.g);
+      }
+
+      Eigen::VectorXd dtau_dq(
+        block_dense_e_point& z,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        return Eigen::VectorXd::Zero(this->model_.num_params_r());
+      }
+
+      Eigen::VectorXd dtau_dp(block_dense_e_point& z) {
+        Eigen::VectorXd p_sharp(z.p.size());
+        int start = 0;
+        for (size_t b = 0; b < z.mInv.size(); ++b) {
+          int n = z.block_sizes[b];
+          p_sharp.segment(start, n).noalias()
+            = z.mInv[b] * z.p.segment(start, n);
+          start += n;
+        }
+        return p_sharp;
+      }
+
+      void compute_kinetic(block_dense_e_point& z) {
+        z.p_sharp = dtau_dp(z);
+        z.tau = 0.5 * z.p.dot(z.p_sharp);
+      }
+
+      Eigen::VectorXd dphi_dq(
+        block_dense_e_point& z,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        return z.g;
+      }
+
+      void sample_p(block_dense_e_point& z, BaseRNG& rng) {
+        boost::variate_generator<BaseRNG&, boost::normal_distribution<> >
+          rand_dense_gaus(rng, boost::normal_distribution<>());
+
+        for (int i = 0; i < z.p.size(); ++i)
+          z.p(i) = rand_dense_gaus();
+
+        // p = L^{-T} u has covariance (L L^T)^{-1} for each block
+        int start = 0;
+        for (size_t b = 0; b < z.mInv_llt.size(); ++b) {
+          int n = z.block_sizes[b];
+          Eigen::VectorXd u = z.p.segment(start, n);
+          z.mInv_llt[b].matrixU().solveInPlace(u);
+          z.p.segment(start, n) = u;
+          start += n;
+        }
+
+        z.invalidate_kinetic();
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
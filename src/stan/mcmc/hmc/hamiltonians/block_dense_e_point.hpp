@@ -0,0 +1,119 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_BLOCK_DENSE_E_POINT_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_BLOCK_DENSE_E_POINT_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
+#include <Eigen/Cholesky>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Point in a phase space with a base
+     * Euclidean manifold with block-diagonal metric
+     *
+     * The blocks cover consecutive parameters, one dense inverse
+     * metric per block, and default to one block per parameter.
+     */
+    class block_dense_e_point: public ps_point {
+    public:
+      explicit block_dense_e_point(int n)
+        : ps_point(n) {
+        set_blocks(std::vector<int>(n, 1));
+      }
+
+      std::vector<int> block_sizes;
+      std::vector<Eigen::MatrixXd> mInv;
+
+      // Cholesky factorizations of the blocks of mInv, which must be
+      // refreshed with update_mInv_factor() whenever mInv is modified
+      std::vector<Eigen::LLT<Eigen::MatrixXd> > mInv_llt;
+
+      /**
+       * Sets the block partition and resets every block of the
+       * inverse metric to the identity.
+       *
+       * @param sizes Sizes of consecutive blocks
+       * @throw std::invalid_argument if a size is not positive or
+       *   the sizes do not add up to the number of parameters
+       */
+      void set_blocks(const std::vector<int>& sizes) {
+        int total = 0;
+        for (size_t b = 0; b < sizes.size(); ++b) {
+          if (sizes[b] <= 0)
+            throw std::invalid_argument("Metric block sizes must be "
+                                        "positive");
+          total += sizes[b];
+        }
+        if (total != q.size())
+          throw std::invalid_argument("Metric block sizes must add up to "
+                                      "the number of parameters");
+
+        block_sizes = sizes;
+        mInv.resize(sizes.size());
+        for (size_t b = 0; b < sizes.size(); ++b)
+          mInv[b] = Eigen::MatrixXd::Identity(sizes[b], sizes[b]);
+        update_mInv_factor();
+      }
+
+      /**
+       * Recomputes the cached Cholesky factorizations of the
+       * blocks, O(sum of cubed block sizes).
+       */
+      void update_mInv_factor() {
+        mInv_llt.resize(mInv.size());
+        for (size_t b = 0; b < mInv.size(); ++b)
+          mInv_llt[b].compute(mInv[b]);
+      }
+
+      void
+      write_metric(stan::interface_callbacks::writer::base_writer& writer) {
+        writer("Blocks of inverse mass matrix:");
+        std::stringstream mInv_ss;
+        for (size_t b = 0; b < mInv.size(); ++b) {
+          for (int i = 0; i < mInv[b].rows(); ++i) {
+            mInv_ss.str("");
+            mInv_ss << mInv[b](i, 0);
+            for (int j = 1; j < mInv[b].cols(); ++j)
+              mInv_ss << ", " << mInv[b](i, j);
+            writer(mInv_ss.str());
+          }
+          if (b + 1 < mInv.size())
+            writer();
+        }
+      }
+
+      /**
+       * Saves the blocks of the inverse metric.  The block partition
+       * must be set before read_state().
+       */
+      void write_state(std::ostream& o) {
+        ps_point::write_state(o);
+        o << mInv.size() << ' ';
+        for (size_t b = 0; b < mInv.size(); ++b)
+          write_chain_state(o, mInv[b]);
+      }
+
+      void read_state(std::istream& in) {
+        ps_point::read_state(in);
+        size_t num_blocks = 0;
+        if (!(in >> num_blocks) || num_blocks != block_sizes.size())
+          throw std::domain_error("Chain state does not match the metric "
+                                  "blocks");
+        for (size_t b = 0; b < num_blocks; ++b) {
+          read_chain_state(in, mInv[b]);
+          if (mInv[b].rows() != block_sizes[b]
+              || mInv[b].cols() != block_sizes[b])
+            throw std::domain_error("Chain state does not match the metric "
+                                    "blocks");
+        }
+        update_mInv_factor();
+      }
+    };
+
+  }  // mcmc
+}  // stan
+
+#endif
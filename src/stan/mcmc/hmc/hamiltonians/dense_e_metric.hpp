@@ -49,6 +49,11 @@ namespace stan {
         return z.mInv * z.p;
       }
 
+      void compute_kinetic(dense_e_point& z) {
+        z.p_sharp.noalias() = z.mInv * z.p;
+        z.tau = 0.5 * z.p.dot(z.p_sharp);
+      }
+
       Eigen::VectorXd dphi_dq(
         dense_e_point& z,
         interface_callbacks::writer::base_writer& info_writer,
@@ -61,12 +66,12 @@ namespace stan {
         boost::variate_generator<BaseRNG&, boost::normal_distribution<> >
           rand_dense_gaus(rng, boost::normal_distribution<>());
 
-        Eigen::VectorXd u(z.p.size());
+        for (idx_t i = 0; i < z.p.size(); ++i)
+          z.p(i) = rand_dense_gaus();
 
-        for (idx_t i = 0; i < u.size(); ++i)
-          u(i) = rand_dense_gaus();
+        z.mInv_L.triangularView<Eigen::Lower>().solveInPlace(z.p);
 
-        z.p = z.mInv.llt().matrixL().solve(u);
+        z.invalidate_kinetic();
       }
     };
 
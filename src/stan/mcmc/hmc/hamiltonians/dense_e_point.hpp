@@ -3,6 +3,8 @@
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
 #include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
+#include <Eigen/Cholesky>
+#include <stdexcept>
 
 namespace stan {
   namespace mcmc {
@@ -13,15 +15,33 @@ namespace stan {
     class dense_e_point: public ps_point {
     public:
       explicit dense_e_point(int n)
-        : ps_point(n), mInv(n, n) {
+        : ps_point(n), mInv(n, n), mInv_L(n, n) {
         mInv.setIdentity();
+        update_mInv_factor();
       }
 
       Eigen::MatrixXd mInv;
 
+      // Lower Cholesky factor of mInv, which must be refreshed
+      // with update_mInv_factor() whenever mInv is modified
+      Eigen::MatrixXd mInv_L;
+
       dense_e_point(const dense_e_point& z)
-        : ps_point(z), mInv(z.mInv.rows(), z.mInv.cols()) {
+        : ps_point(z), mInv(z.mInv.rows(), z.mInv.cols()),
+          mInv_L(z.mInv_L.rows(), z.mInv_L.cols()) {
         fast_matrix_copy_<double>(mInv, z.mInv);
+        fast_matrix_copy_<double>(mInv_L, z.mInv_L);
+      }
+
+      /**
+       * Recomputes the cached Cholesky factorization of the
+       * inverse metric.  This is O(D^3) and should only be
+       * called when mInv changes, such as at the end of an
+       * adaptation window, unless the adaptation provides the
+       * factor itself.
+       */
+      void update_mInv_factor() {
+        mInv_L = mInv.llt().matrixL();
       }
 
       void
@@ -36,6 +56,32 @@ namespace stan {
           writer(mInv_ss.str());
         }
       }
+
+      // mInv is symmetric, so its column-major storage is also
+      // the row-major order the writer expects
+      void
+      write_inv_metric(stan::interface_callbacks::writer::base_writer&
+                       writer) {
+        writer("inv_metric", mInv.data(), mInv.rows(), mInv.cols());
+      }
+
+      // The factor is saved rather than recomputed, as a factor
+      // updated during adaptation differs in the last bits
+      void write_state(std::ostream& o) {
+        ps_point::write_state(o);
+        write_chain_state(o, mInv);
+        write_chain_state(o, mInv_L);
+      }
+
+      void read_state(std::istream& in) {
+        ps_point::read_state(in);
+        read_chain_state(in, mInv);
+        read_chain_state(in, mInv_L);
+        if (mInv.rows() != q.size() || mInv.cols() != q.size()
+            || mInv_L.rows() != q.size() || mInv_L.cols() != q.size())
+          throw std::domain_error("Chain state does not match the number "
+                                  "of parameters");
+      }
     };
 
   }  // mcmc
@@ -45,6 +45,11 @@ namespace stan {
         return z.mInv.cwiseProduct(z.p);
       }
 
+      void compute_kinetic(diag_e_point& z) {
+        z.p_sharp = z.mInv.cwiseProduct(z.p);
+        z.tau = 0.5 * z.p.dot(z.p_sharp);
+      }
+
       Eigen::VectorXd dphi_dq(
         diag_e_point& z,
         interface_callbacks::writer::base_writer& info_writer,
@@ -58,6 +63,8 @@ namespace stan {
 
         for (int i = 0; i < z.p.size(); ++i)
           z.p(i) = rand_diag_gaus() / sqrt(z.mInv(i));
+
+        z.invalidate_kinetic();
       }
     };
 
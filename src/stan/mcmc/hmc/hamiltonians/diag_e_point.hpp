@@ -32,6 +32,22 @@ namespace stan {
           mInv_ss << ", " << mInv(i);
         writer(mInv_ss.str());
       }
+
+      void
+      write_inv_metric(stan::interface_callbacks::writer::base_writer&
+                       writer) {
+        writer("inv_metric", mInv.data(), mInv.size());
+      }
+
+      void write_state(std::ostream& o) {
+        ps_point::write_state(o);
+        write_chain_state(o, mInv);
+      }
+
+      void read_state(std::istream& in) {
+        ps_point::read_state(in);
+        read_chain_state(in, mInv, q.size());
+      }
     };
 
   }  // mcmc
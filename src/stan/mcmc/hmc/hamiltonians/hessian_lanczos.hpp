@@ -0,0 +1,155 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_HESSIAN_LANCZOS_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_HESSIAN_LANCZOS_HPP
+
+#include <stan/math/mix/mat.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Eigenpairs of largest magnitude of the Hessian of -f at x,
+     * found by the Lanczos iteration with full reorthogonalization
+     * using only Hessian-vector products.
+     *
+     * The iteration starts from the normalized start vector and
+     * restarts from unit vectors on breakdown, so the result is a
+     * deterministic function of x and the start.  A start close to
+     * the span of the wanted eigenvectors, such as their sum at a
+     * nearby point, converges in fewer products.  It stops once the
+     * residuals ||H u - lambda u|| of the k Ritz pairs are below tol
+     * times the largest Ritz value magnitude, or once the Krylov
+     * space spans the whole space.
+     *
+     * @tparam F Functor returning f
+     * @param[in] f Functor
+     * @param[in] x Point at which the Hessian is evaluated
+     * @param[in] k Number of eigenpairs, at most x.size()
+     * @param[in] tol Relative residual tolerance
+     * @param[in] start Nonzero start vector
+     * @param[out] eigenvalues Eigenvalues by decreasing magnitude
+     * @param[out] eigenvectors Corresponding orthonormal eigenvectors
+     * @return Number of Hessian-vector products
+     */
+    template <class F>
+    int hessian_lanczos(const F& f, const Eigen::VectorXd& x, int k,
+                        double tol, const Eigen::VectorXd& start,
+                        Eigen::VectorXd& eigenvalues,
+                        Eigen::MatrixXd& eigenvectors) {
+      const int D = x.size();
+      if (k > D)
+        k = D;
+
+      std::vector<Eigen::VectorXd> basis;
+      std::vector<double> alpha;
+      std::vector<double> beta;
+
+      basis.push_back(start / start.norm());
+
+      Eigen::VectorXd w(D);
+      Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> T_deco;
+      std::vector<int> order;
+      double fx;
+      int next_unit = 0;
+
+      for (int j = 0; ; ++j) {
+        stan::math::hessian_times_vector(f, x, basis[j], fx, w);
+        w = -w;
+
+        double a = basis[j].dot(w);
+        alpha.push_back(a);
+
+        // Full reorthogonalization, twice for stability
+        for (int pass = 0; pass < 2; ++pass)
+          for (int i = 0; i <= j; ++i)
+            w -= basis[i].dot(w) * basis[i];
+        double b = w.norm();
+
+        const int m = j + 1;
+        Eigen::MatrixXd T = Eigen::MatrixXd::Zero(m, m);
+        for (int i = 0; i < m; ++i) {
+          T(i, i) = alpha[i];
+          if (i + 1 < m) {
+            T(i, i + 1) = beta[i];
+            T(i + 1, i) = beta[i];
+          }
+        }
+        T_deco.compute(T);
+
+        // Ritz values by decreasing magnitude
+        order.resize(m);
+        for (int i = 0; i < m; ++i)
+          order[i] = i;
+        for (int i = 1; i < m; ++i)
+          for (int l = i; l > 0
+                 && std::fabs(T_deco.eigenvalues()(order[l]))
+                    > std::fabs(T_deco.eigenvalues()(order[l - 1])); --l)
+            std::swap(order[l], order[l - 1]);
+
+        if (m == D)
+          break;
+
+        if (m >= k) {
+          double scale = std::fabs(T_deco.eigenvalues()(order[0]));
+          bool converged = true;
+          for (int i = 0; i < k && converged; ++i)
+            converged = b * std::fabs(T_deco.eigenvectors()(m - 1, order[i]))
+                        <= tol * scale;
+          if (converged)
+            break;
+        }
+
+        // On breakdown continue from a unit vector outside the
+        // Krylov space found so far
+        if (b <= 1e-12 * (std::fabs(a) + 1)) {
+          b = 0;
+          while (b <= 1e-8 && next_unit < D) {
+            w.setZero();
+            w(next_unit++) = 1;
+            for (int pass = 0; pass < 2; ++pass)
+              for (int i = 0; i <= j; ++i)
+                w -= basis[i].dot(w) * basis[i];
+            b = w.norm();
+          }
+          if (b <= 1e-8)
+            throw std::domain_error("Lanczos iteration failed to extend "
+                                    "the Krylov space");
+          basis.push_back(w / b);
+          beta.push_back(0);
+        } else {
+          basis.push_back(w / b);
+          beta.push_back(b);
+        }
+      }
+
+      const int m = basis.size();
+      eigenvalues.resize(k);
+      eigenvectors.setZero(D, k);
+      for (int i = 0; i < k; ++i) {
+        eigenvalues(i) = T_deco.eigenvalues()(order[i]);
+        for (int l = 0; l < m; ++l)
+          eigenvectors.col(i) += T_deco.eigenvectors()(l, order[i]) * basis[l];
+      }
+
+      return m;
+    }
+
+    /**
+     * Eigenpairs of largest magnitude of the Hessian of -f at x,
+     * starting the Lanczos iteration from the vector of ones.
+     */
+    template <class F>
+    int hessian_lanczos(const F& f, const Eigen::VectorXd& x, int k,
+                        double tol, Eigen::VectorXd& eigenvalues,
+                        Eigen::MatrixXd& eigenvectors) {
+      return hessian_lanczos(f, x, k, tol, Eigen::VectorXd::Ones(x.size()),
+                             eigenvalues, eigenvectors);
+    }
+
+  }  // mcmc
+}  // stan
+#endif
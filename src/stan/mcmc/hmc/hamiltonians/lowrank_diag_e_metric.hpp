@@ -0,0 +1,99 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_LOWRANK_DIAG_E_METRIC_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_LOWRANK_DIAG_E_METRIC_HPP
+
+#include <stan/mcmc/hmc/hamiltonians/base_hamiltonian.hpp>
+#include <stan/mcmc/hmc/hamiltonians/lowrank_diag_e_point.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <cmath>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Euclidean manifold with low-rank plus diagonal metric.
+     *
+     * Products with the metric and its square root cost O(D k)
+     * for k kept directions; with no directions this is the
+     * diagonal metric.
+     */
+    template <class Model, class BaseRNG>
+    class lowrank_diag_e_metric
+      : public base_hamiltonian<Model, lowrank_diag_e_point, BaseRNG> {
+    public:
+      explicit lowrank_diag_e_metric(const Model& model)
+        : base_hamiltonian<Model, lowrank_diag_e_point, BaseRNG>(model) {}
+
+      double T(lowrank_diag_e_point& z) {
+        return 0.5 * z.p.dot(dtau_dp(z));
+      }
+
+      double tau(lowrank_diag_e_point& z) {
+        return T(z);
+      }
+
+      double phi(lowrank_diag_e_point& z) {
+        return this->V(z);
+      }
+
+      double dG_dt(lowrank_diag_e_point& z,
+                   interface_callbacks::writer::base_writer& info_writer,
+                   interface_callbacks::writer::base_writer& error_writer) {
+        return 2 * T(z) - z.q.dot(z.g);
+      }
+
+      Eigen::VectorXd dtau_dq(
+        lowrank_diag_e_point& z,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        return Eigen::VectorXd::Zero(this->model_.num_params_r());
+      }
+
+      Eigen::VectorXd dtau_dp(lowrank_diag_e_point& z) {
+        Eigen::VectorXd p_sharp = z.mInv.cwiseProduct(z.p);
+        if (z.mInv_U.cols() > 0) {
+          Eigen::VectorXd c
+            = z.mInv_lambda.cwiseProduct(
+                z.mInv_U.transpose() * z.mInv_sqrt.cwiseProduct(z.p));
+          p_sharp += z.mInv_sqrt.cwiseProduct(z.mInv_U * c);
+        }
+        return p_sharp;
+      }
+
+      void compute_kinetic(lowrank_diag_e_point& z) {
+        z.p_sharp = dtau_dp(z);
+        z.tau = 0.5 * z.p.dot(z.p_sharp);
+      }
+
+      Eigen::VectorXd dphi_dq(
+        lowrank_diag_e_point& z,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        return z.g;
+      }
+
+      void sample_p(lowrank_diag_e_point& z, BaseRNG& rng) {
+        boost::variate_generator<BaseRNG&, boost::normal_distribution<> >
+          rand_diag_gaus(rng, boost::normal_distribution<>());
+
+        Eigen::VectorXd a(z.p.size());
+        for (int i = 0; i < a.size(); ++i)
+          a(i) = rand_diag_gaus();
+
+        // (I + U diag(lambda) U^T)^{-1/2}
+        //   = I + U ((1 + lambda)^{-1/2} - 1) U^T
+        if (z.mInv_U.cols() > 0) {
+          Eigen::VectorXd c
+            = ((1.0 + z.mInv_lambda.array()).sqrt().inverse() - 1.0)
+              .matrix().cwiseProduct(z.mInv_U.transpose() * a);
+          a += z.mInv_U * c;
+        }
+
+        z.p = a.cwiseQuotient(z.mInv_sqrt);
+        z.invalidate_kinetic();
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
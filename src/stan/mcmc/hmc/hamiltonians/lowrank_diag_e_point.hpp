@@ -0,0 +1,81 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_LOWRANK_DIAG_E_POINT_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_LOWRANK_DIAG_E_POINT_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
+#include <sstream>
+#include <stdexcept>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Point in a phase space with a base
+     * Euclidean manifold with low-rank plus diagonal metric
+     *
+     * The inverse metric is S (I + U diag(lambda) U^T) S, with
+     * S = diag(mInv)^{1/2} and orthonormal columns in U.
+     */
+    class lowrank_diag_e_point: public ps_point {
+    public:
+      explicit lowrank_diag_e_point(int n)
+        : ps_point(n), mInv(n), mInv_U(n, 0), mInv_lambda(0),
+          mInv_sqrt(n) {
+        mInv.setOnes();
+        update_mInv_factor();
+      }
+
+      Eigen::VectorXd mInv;
+      Eigen::MatrixXd mInv_U;
+      Eigen::VectorXd mInv_lambda;
+
+      // Square root of mInv, which must be refreshed
+      // with update_mInv_factor() whenever mInv is modified
+      Eigen::VectorXd mInv_sqrt;
+
+      void update_mInv_factor() {
+        mInv_sqrt = mInv.cwiseSqrt();
+      }
+
+      void
+      write_metric(stan::interface_callbacks::writer::base_writer& writer) {
+        writer("Diagonal elements of inverse mass matrix:");
+        std::stringstream mInv_ss;
+        mInv_ss << mInv(0);
+        for (int i = 1; i < mInv.size(); ++i)
+          mInv_ss << ", " << mInv(i);
+        writer(mInv_ss.str());
+
+        writer("Low-rank eigenvalues and directions of scaled "
+               "inverse mass matrix:");
+        for (int j = 0; j < mInv_U.cols(); ++j) {
+          mInv_ss.str("");
+          mInv_ss << mInv_lambda(j);
+          for (int i = 0; i < mInv_U.rows(); ++i)
+            mInv_ss << ", " << mInv_U(i, j);
+          writer(mInv_ss.str());
+        }
+      }
+
+      void write_state(std::ostream& o) {
+        ps_point::write_state(o);
+        write_chain_state(o, mInv);
+        write_chain_state(o, mInv_U);
+        write_chain_state(o, mInv_lambda);
+      }
+
+      void read_state(std::istream& in) {
+        ps_point::read_state(in);
+        read_chain_state(in, mInv, q.size());
+        read_chain_state(in, mInv_U);
+        read_chain_state(in, mInv_lambda);
+        if (mInv_U.rows() != q.size() || mInv_U.cols() != mInv_lambda.size())
+          throw std::domain_error("Chain state does not match the number "
+                                  "of parameters");
+        update_mInv_factor();
+      }
+    };
+
+  }  // mcmc
+}  // stan
+
+#endif
@@ -0,0 +1,433 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_LOWRANK_SOFTABS_METRIC_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_LOWRANK_SOFTABS_METRIC_HPP
+
+#include <stan/math/mix/mat.hpp>
+
+#include <stan/mcmc/hmc/hamiltonians/base_hamiltonian.hpp>
+#include <stan/mcmc/hmc/hamiltonians/hessian_lanczos.hpp>
+#include <stan/mcmc/hmc/hamiltonians/lowrank_softabs_point.hpp>
+#include <stan/mcmc/hmc/hamiltonians/softabs_metric.hpp>
+#include <stan/model/count_gradient.hpp>
+
+#include <boost/random/variate_generator.hpp>
+#include <boost/random/normal_distribution.hpp>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Riemannian manifold with a low-rank SoftAbs metric.
+     *
+     * Only the rank eigenpairs of the Hessian of the potential with
+     * largest magnitude are found, by a Lanczos iteration on
+     * Hessian-vector products, and the metric is
+     *
+     *   G = I + U (softabs(Lambda) - I) U^T,
+     *
+     * the SoftAbs metric along those directions and the identity
+     * elsewhere.  Memory is O(D rank) and no Hessian is formed.
+     *
+     * The gradients of the kinetic energy are exact for this metric
+     * up to the tolerance of the point: besides the terms of the full
+     * SoftAbs metric restricted to the kept directions, the rotation
+     * of the kept directions into the rest of the space needs the
+     * resolvent of the Hessian on the complement at each kept
+     * eigenvalue.  The resolvents are shifts of one operator, so a
+     * single MINRES Krylov space solves all of them, iterating until
+     * every residual is below the tolerance.  A solve that has not
+     * converged after max_num_resolvent Hessian-vector products is
+     * reported to the error writer and makes phi infinite, which
+     * rejects the trajectory; init() clears the failure.
+     * The Lanczos iteration starts from the eigenvectors of the last
+     * update, so the fixed point iterations of the implicit
+     * integrator reuse the directions they have already found.
+     * Third derivatives are taken as gradients of Hessian bilinear
+     * forms, one nested sweep per kept direction instead of one per
+     * parameter.  The metric is discontinuous where an eigenvalue
+     * leaves the kept set, so the rank should cover a clear gap in
+     * the spectrum.
+     */
+    template <class Model, class BaseRNG>
+    class lowrank_softabs_metric
+      : public base_hamiltonian<Model, lowrank_softabs_point, BaseRNG> {
+    private:
+      typedef typename stan::math::index_type<Eigen::VectorXd>::type idx_t;
+      typedef softabs_metric<Model, BaseRNG> softabs_t;
+
+    public:
+      explicit lowrank_softabs_metric(const Model& model)
+        : base_hamiltonian<Model, lowrank_softabs_point, BaseRNG>(model) {}
+
+      double T(lowrank_softabs_point& z) {
+        return this->tau(z) + 0.5 * z.log_det_metric;
+      }
+
+      double tau(lowrank_softabs_point& z) {
+        return 0.5 * z.p.dot(dtau_dp(z));
+      }
+
+      double phi(lowrank_softabs_point& z) {
+        if (z.resolvent_failed)
+          return std::numeric_limits<double>::infinity();
+        return this->V(z) + 0.5 * z.log_det_metric;
+      }
+
+      double dG_dt(lowrank_softabs_point& z,
+                   interface_callbacks::writer::base_writer& info_writer,
+                   interface_callbacks::writer::base_writer& error_writer) {
+        return 2 * T(z)
+               - z.q.dot(dtau_dq(z, info_writer, error_writer)
+               + dphi_dq(z, info_writer, error_writer));
+      }
+
+      Eigen::VectorXd dtau_dq(
+        lowrank_softabs_point& z,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        const int k = z.U.cols();
+        const int D = z.q.size();
+
+        Eigen::VectorXd b = z.U.transpose() * z.p;
+        Eigen::VectorXd a = z.softabs_lambda_inv.cwiseProduct(b);
+
+        // Terms within the kept directions, as for the full metric,
+        // diagonalized to one bilinear form per direction
+        Eigen::MatrixXd C = a.asDiagonal()
+                            * z.pseudo_j.selfadjointView<Eigen::Lower>()
+                            * a.asDiagonal();
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> C_deco(C);
+
+        Eigen::MatrixXd left(D, 2 * k);
+        Eigen::MatrixXd right(D, 2 * k);
+        Eigen::VectorXd coef(2 * k);
+        left.leftCols(k) = z.U * C_deco.eigenvectors();
+        right.leftCols(k) = left.leftCols(k);
+        coef.head(k) = C_deco.eigenvalues();
+
+        // Rotation of the kept directions into the complement
+        left.rightCols(k) = z.U;
+        if (k < D) {
+          Eigen::VectorXd r = z.p - z.U * b;
+          Eigen::MatrixXd Y;
+          if (!resolvents_(z, r, Y) && !z.resolvent_failed) {
+            std::stringstream msg;
+            msg << "Low-rank SoftAbs resolvent solve did not converge in "
+                << max_num_resolvent_(z) << " Hessian-vector products";
+            this->write_error_msg_(std::domain_error(msg.str()),
+                                   error_writer);
+            z.resolvent_failed = true;
+          }
+          right.rightCols(k) = Y;
+          for (int i = 0; i < k; ++i)
+            coef(k + i) = -2 * b(i) * (z.softabs_lambda_inv(i) - 1);
+        } else {
+          right.rightCols(k).setZero();
+          coef.tail(k).setZero();
+        }
+
+        Eigen::VectorXd grad;
+        grad_hessian_forms_(z.q, left, right, coef, grad);
+        return 0.5 * grad;
+      }
+
+      Eigen::VectorXd dtau_dp(lowrank_softabs_point& z) {
+        return z.p
+               + z.U * (z.softabs_lambda_inv.array() - 1.0).matrix()
+                       .cwiseProduct(z.U.transpose() * z.p);
+      }
+
+      void compute_kinetic(lowrank_softabs_point& z) {
+        z.p_sharp = dtau_dp(z);
+        z.tau = 0.5 * z.p.dot(z.p_sharp);
+      }
+
+      Eigen::VectorXd dphi_dq(
+        lowrank_softabs_point& z,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        if (!z.log_det_grad_cached()) {
+          Eigen::VectorXd a
+            = z.softabs_lambda_inv.cwiseProduct(z.pseudo_j.diagonal());
+
+          Eigen::VectorXd grad;
+          grad_hessian_forms_(z.q, z.U, z.U, a, grad);
+          z.log_det_grad = - 0.5 * grad;
+          z.log_det_grad_q = z.q;
+        }
+
+        return z.log_det_grad + z.g;
+      }
+
+      void sample_p(lowrank_softabs_point& z, BaseRNG& rng) {
+        boost::variate_generator<BaseRNG&, boost::normal_distribution<> >
+          rand_unit_gaus(rng, boost::normal_distribution<>());
+
+        Eigen::VectorXd a(z.p.size());
+        for (idx_t n = 0; n < z.p.size(); ++n)
+          a(n) = rand_unit_gaus();
+
+        // G^{1/2} = I + U (softabs(Lambda)^{1/2} - I) U^T
+        z.p = a + z.U * (z.softabs_lambda.array().sqrt() - 1.0).matrix()
+                        .cwiseProduct(z.U.transpose() * a);
+        z.invalidate_kinetic();
+      }
+
+      void init(
+        lowrank_softabs_point& z,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        z.resolvent_failed = false;
+        update_metric(z, info_writer, error_writer);
+        update_metric_gradient(z, info_writer, error_writer);
+      }
+
+      void update_metric(
+        lowrank_softabs_point& z,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        z.log_det_grad_q.resize(0);
+        softabs_fun<Model> f(this->model_, 0);
+
+        using stan::model::count_gradient;
+        count_gradient(this->model_);
+        stan::math::gradient(f, z.q, z.V, z.g);
+        z.V = -z.V;
+        z.g = -z.g;
+
+        // Start from the directions of the last update, if any
+        Eigen::VectorXd start = Eigen::VectorXd::Ones(z.q.size());
+        if (z.U.cols() > 0 && z.U.rows() == z.q.size()) {
+          Eigen::VectorXd u = z.U.rowwise().sum();
+          if (u.norm() > 1e-8)
+            start = u;
+        }
+        hessian_lanczos(f, z.q, z.rank, z.tol, start, z.lambda, z.U);
+
+        const int k = z.lambda.size();
+        z.softabs_lambda.resize(k);
+        z.softabs_lambda_inv.resize(k);
+
+        for (int i = 0; i < k; ++i) {
+          double lambda = z.lambda(i);
+          double alpha_lambda = z.alpha * lambda;
+
+          double softabs_lambda = 0;
+
+          if (std::fabs(alpha_lambda) < softabs_t::lower_softabs_thresh) {
+            softabs_lambda = (1.0
+                              + (1.0 / 3.0) * alpha_lambda * alpha_lambda)
+                              / z.alpha;
+          } else if (std::fabs(alpha_lambda)
+                     > softabs_t::upper_softabs_thresh) {
+            softabs_lambda = std::fabs(lambda);
+          } else {
+            softabs_lambda = lambda / std::tanh(alpha_lambda);
+          }
+
+          z.softabs_lambda(i) = softabs_lambda;
+          z.softabs_lambda_inv(i) = 1.0 / softabs_lambda;
+        }
+
+        // The identity part of the metric adds nothing
+        z.log_det_metric = 0;
+        for (int i = 0; i < k; ++i)
+          z.log_det_metric += std::log(z.softabs_lambda(i));
+      }
+
+      void update_metric_gradient(
+        lowrank_softabs_point& z,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        const int k = z.lambda.size();
+        z.pseudo_j.resize(k, k);
+
+        for (int i = 0; i < k; ++i) {
+          for (int j = 0; j <= i; ++j) {
+            double delta = z.lambda(i) - z.lambda(j);
+
+            if (std::fabs(delta) < softabs_t::jacobian_thresh) {
+              double lambda = z.lambda(i);
+              double alpha_lambda = z.alpha * lambda;
+
+              if (std::fabs(alpha_lambda) < softabs_t::lower_softabs_thresh) {
+                z.pseudo_j(i, j) =   (2.0 / 3.0) * alpha_lambda
+                                   * (1.0 -   (2.0 / 15.0)
+                                            * alpha_lambda * alpha_lambda);
+              } else if (std::fabs(alpha_lambda)
+                         > softabs_t::upper_softabs_thresh) {
+                z.pseudo_j(i, j) = lambda > 0 ? 1 : -1;
+              } else {
+                double sdx = std::sinh(alpha_lambda) / lambda;
+                z.pseudo_j(i, j) = (z.softabs_lambda(i)
+                                    - z.alpha / (sdx * sdx) ) / lambda;
+              }
+            } else {
+              z.pseudo_j(i, j) = (z.softabs_lambda(i)
+                                  - z.softabs_lambda(j) ) / delta;
+            }
+          }
+        }
+      }
+
+      void update_gradients(
+        lowrank_softabs_point& z,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        update_metric_gradient(z, info_writer, error_writer);
+      }
+
+    private:
+      // Gradient of sum_l coef_l left_l^T Hess(log p) right_l with
+      // left and right held fixed, one nested sweep per term
+      void grad_hessian_forms_(const Eigen::VectorXd& q,
+                               const Eigen::MatrixXd& left,
+                               const Eigen::MatrixXd& right,
+                               const Eigen::VectorXd& coef,
+                               Eigen::VectorXd& grad) {
+        using stan::math::fvar;
+        using stan::math::var;
+
+        softabs_fun<Model> f(this->model_, 0);
+        grad.setZero(q.size());
+
+        stan::math::start_nested();
+        try {
+          Eigen::Matrix<var, Eigen::Dynamic, 1> q_var(q.size());
+          for (idx_t i = 0; i < q.size(); ++i)
+            q_var(i) = q(i);
+
+          Eigen::Matrix<fvar<fvar<var> >, Eigen::Dynamic, 1> x(q.size());
+          var sum(0);
+
+          for (idx_t l = 0; l < coef.size(); ++l) {
+            if (coef(l) == 0)
+              continue;
+            for (idx_t i = 0; i < q.size(); ++i)
+              x(i) = fvar<fvar<var> >(fvar<var>(q_var(i), right(i, l)),
+                                      fvar<var>(left(i, l), 0));
+            fvar<fvar<var> > fx = f(x);
+            sum += coef(l) * fx.d_.d_;
+          }
+
+          stan::math::grad(sum.vi_);
+          for (idx_t i = 0; i < q.size(); ++i)
+            grad(i) = q_var(i).adj();
+        } catch (const std::exception& e) {
+          stan::math::recover_memory_nested();
+          throw;
+        }
+        stan::math::recover_memory_nested();
+      }
+
+      // Complement projection of the Hessian of the potential
+      void projected_hessian_times_(lowrank_softabs_point& z,
+                                    const Eigen::VectorXd& v,
+                                    Eigen::VectorXd& Hv) {
+        double fx;
+        Eigen::VectorXd Pv = v - z.U * (z.U.transpose() * v);
+        stan::math::hessian_times_vector(softabs_fun<Model>(this->model_, 0),
+                                         z.q, Pv, fx, Hv);
+        Hv = -Hv;
+        Hv -= z.U * (z.U.transpose() * Hv);
+      }
+
+      int max_num_resolvent_(const lowrank_softabs_point& z) const {
+        return z.max_num_resolvent > 0
+               ? z.max_num_resolvent : 2 * static_cast<int>(z.q.size());
+      }
+
+      // Solves (lambda_i I - P H P) y_i = r on the complement of the
+      // kept directions for every kept eigenvalue lambda_i by MINRES
+      // (Paige and Saunders, 1975).  The shifted operators share the
+      // Lanczos vectors of P H P, so each shift only carries its own
+      // scalar recurrences and search directions.  Returns whether
+      // every residual fell below the tolerance relative to r, which
+      // is floored at the square root of machine precision.
+      bool resolvents_(lowrank_softabs_point& z,
+                       const Eigen::VectorXd& r, Eigen::MatrixXd& Y) {
+        const int D = r.size();
+        const int k = z.lambda.size();
+        Y.setZero(D, k);
+
+        double beta1 = r.norm();
+        if (beta1 == 0)
+          return true;
+
+        double tol = std::sqrt(std::numeric_limits<double>::epsilon());
+        if (z.tol > tol)
+          tol = z.tol;
+
+        Eigen::VectorXd v_prev = Eigen::VectorXd::Zero(D);
+        Eigen::VectorXd v = r / beta1;
+        Eigen::VectorXd Av(D);
+
+        Eigen::MatrixXd w = Eigen::MatrixXd::Zero(D, k);
+        Eigen::MatrixXd w1(D, k);
+        Eigen::MatrixXd w2 = Eigen::MatrixXd::Zero(D, k);
+
+        Eigen::VectorXd dbar = Eigen::VectorXd::Zero(k);
+        Eigen::VectorXd epsln = Eigen::VectorXd::Zero(k);
+        Eigen::VectorXd phibar = Eigen::VectorXd::Constant(k, beta1);
+        Eigen::VectorXd cs = Eigen::VectorXd::Constant(k, -1);
+        Eigen::VectorXd sn = Eigen::VectorXd::Zero(k);
+
+        double beta = beta1;
+        double sign = 1;
+        const int max_n = max_num_resolvent_(z);
+
+        for (int n = 0; n < max_n; ++n) {
+          projected_hessian_times_(z, v, Av);
+          Av -= beta * v_prev;
+          double alfa = v.dot(Av);
+          Av -= alfa * v;
+          beta = Av.norm();
+
+          // The Lanczos vectors of lambda_i I - P H P alternate in
+          // sign with those of P H P
+          bool converged = true;
+          for (int i = 0; i < k; ++i) {
+            double alfa_i = z.lambda(i) - alfa;
+            double oldeps = epsln(i);
+            double delta = cs(i) * dbar(i) + sn(i) * alfa_i;
+            double gbar = sn(i) * dbar(i) - cs(i) * alfa_i;
+            epsln(i) = sn(i) * beta;
+            dbar(i) = - cs(i) * beta;
+
+            double gamma = std::sqrt(gbar * gbar + beta * beta);
+            if (gamma < std::numeric_limits<double>::epsilon())
+              gamma = std::numeric_limits<double>::epsilon();
+            cs(i) = gbar / gamma;
+            sn(i) = beta / gamma;
+            double phi = cs(i) * phibar(i);
+            phibar(i) = sn(i) * phibar(i);
+
+            w1.col(i) = w2.col(i);
+            w2.col(i) = w.col(i);
+            w.col(i) = (sign * v - oldeps * w1.col(i)
+                        - delta * w2.col(i)) / gamma;
+            Y.col(i) += phi * w.col(i);
+
+            converged = converged
+                        && std::fabs(phibar(i)) < tol * beta1;
+          }
+
+          // The Krylov space is exhausted once beta vanishes, and the
+          // solves are then exact
+          if (converged || beta == 0)
+            return true;
+
+          v_prev = v;
+          v = Av / beta;
+          sign = -sign;
+        }
+        return false;
+      }
+    };
+  }  // mcmc
+}  // stan
+#endif
@@ -0,0 +1,83 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_LOWRANK_SOFTABS_POINT_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_LOWRANK_SOFTABS_POINT_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Point in a phase space with a base
+     * Riemannian manifold with low-rank SoftAbs metric
+     */
+    class lowrank_softabs_point: public ps_point {
+    public:
+      explicit lowrank_softabs_point(int n):
+        ps_point(n),
+        alpha(1.0),
+        rank(n < 10 ? n : 10),
+        tol(1e-10),
+        max_num_resolvent(0),
+        resolvent_failed(false),
+        lambda(Eigen::VectorXd::Zero(0)),
+        U(Eigen::MatrixXd::Zero(n, 0)),
+        log_det_metric(0),
+        softabs_lambda(Eigen::VectorXd::Zero(0)),
+        softabs_lambda_inv(Eigen::VectorXd::Zero(0)),
+        pseudo_j(Eigen::MatrixXd::Zero(0, 0)),
+        log_det_grad(Eigen::VectorXd::Zero(n)),
+        log_det_grad_q(Eigen::VectorXd::Zero(0)) {}
+
+      // SoftAbs regularization parameter
+      double alpha;
+
+      // Number of curvature directions kept
+      int rank;
+
+      // Relative residual at which the Lanczos eigenpairs and the
+      // solves of the resolvent are considered converged
+      double tol;
+
+      // Maximum number of Hessian-vector products per resolvent
+      // solve, covering all kept directions, or 0 for twice the
+      // dimension
+      int max_num_resolvent;
+
+      // Set when a resolvent solve misses its tolerance, which
+      // rejects the trajectory until the next transition
+      bool resolvent_failed;
+
+      // Eigenvalues of the Hessian of largest magnitude and
+      // their eigenvectors, one per column
+      Eigen::VectorXd lambda;
+      Eigen::MatrixXd U;
+
+      // Log determinant of metric
+      double log_det_metric;
+
+      // SoftAbs transformed eigenvalues
+      Eigen::VectorXd softabs_lambda;
+      Eigen::VectorXd softabs_lambda_inv;
+
+      // Psuedo-Jacobian of the kept eigenvalues
+      Eigen::MatrixXd pseudo_j;
+
+      // Gradient of the log determinant term of phi, which only
+      // depends on q, cached for the position log_det_grad_q
+      Eigen::VectorXd log_det_grad;
+      Eigen::VectorXd log_det_grad_q;
+
+      bool log_det_grad_cached() const {
+        return log_det_grad_q.size() == q.size() && log_det_grad_q == q;
+      }
+
+      virtual void
+      write_metric(stan::interface_callbacks::writer::base_writer& writer) {
+        writer("No free parameters for low-rank SoftAbs metric");
+      }
+    };
+
+  }  // mcmc
+}  // stan
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_METRIC_BLOCKS_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_METRIC_BLOCKS_HPP
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Partitions the parameters into one metric block per declared
+     * variable, from unconstrained parameter names such as "beta.2.1"
+     * where the variable name precedes the first '.'.
+     *
+     * @param[in] names Unconstrained parameter names in order
+     * @param[out] sizes Sizes of consecutive blocks
+     */
+    inline void metric_blocks_from_names(
+      const std::vector<std::string>& names,
+      std::vector<int>& sizes) {
+      sizes.clear();
+      std::string current;
+      for (size_t i = 0; i < names.size(); ++i) {
+        std::string base = names[i].substr(0, names[i].find('.'));
+        if (sizes.empty() || base != current) {
+          sizes.push_back(0);
+          current = base;
+        }
+        ++sizes.back();
+      }
+    }
+
+    /**
+     * Parses a comma separated list of metric block sizes.
+     *
+     * @param[in] spec List such as "3,1,4"
+     * @param[out] sizes Sizes of consecutive blocks
+     * @throw std::invalid_argument if an entry is not a positive
+     *   integer
+     */
+    inline void metric_blocks_from_string(const std::string& spec,
+                                          std::vector<int>& sizes) {
+      sizes.clear();
+      std::stringstream spec_ss(spec);
+      std::string entry;
+      while (std::getline(spec_ss, entry, ',')) {
+        std::stringstream entry_ss(entry);
+        int size = 0;
+        std::string rest;
+        if (!(entry_ss >> size) || (entry_ss >> rest) || size <= 0)
+          throw std::invalid_argument("Invalid metric block size \""
+                                      + entry + "\"");
+        sizes.push_back(size);
+      }
+    }
+
+  }  // mcmc
+}  // stan
+#endif
@@ -3,7 +3,10 @@
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/mcmc/chain_state.hpp>
 #include <boost/lexical_cast.hpp>
+#include <istream>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -19,13 +22,16 @@ namespace stan {
 
     public:
       explicit ps_point(int n)
-        : q(n), p(n), V(0), g(n) {}
+        : q(n), p(n), V(0), g(n), p_sharp(n), tau(0), kinetic_cached(false) {}
 
       ps_point(const ps_point& z)
-        : q(z.q.size()), p(z.p.size()), V(z.V), g(z.g.size()) {
+        : q(z.q.size()), p(z.p.size()), V(z.V), g(z.g.size()),
+          p_sharp(z.p_sharp.size()), tau(z.tau),
+          kinetic_cached(z.kinetic_cached) {
         fast_vector_copy_<double>(q, z.q);
         fast_vector_copy_<double>(p, z.p);
         fast_vector_copy_<double>(g, z.g);
+        fast_vector_copy_<double>(p_sharp, z.p_sharp);
       }
 
       ps_point& operator= (const ps_point& z) {
@@ -39,6 +45,10 @@ namespace stan {
         fast_vector_copy_<double>(p, z.p);
         fast_vector_copy_<double>(g, z.g);
 
+        fast_vector_copy_<double>(p_sharp, z.p_sharp);
+        tau = z.tau;
+        kinetic_cached = z.kinetic_cached;
+
         return *this;
       }
 
@@ -48,6 +58,20 @@ namespace stan {
       double V;
       Eigen::VectorXd g;
 
+      // Velocity dtau/dp and kinetic energy tau cached by
+      // base_hamiltonian::update_kinetic, valid while kinetic_cached
+      Eigen::VectorXd p_sharp;
+      double tau;
+      bool kinetic_cached;
+
+      /**
+       * Marks the cached kinetic terms as stale.  Must be called
+       * whenever p, q, or the metric at q is modified.
+       */
+      void invalidate_kinetic() {
+        kinetic_cached = false;
+      }
+
       virtual void get_param_names(std::vector<std::string>& model_names,
                                    std::vector<std::string>& names) {
         for (int i = 0; i < q.size(); ++i)
@@ -75,6 +99,36 @@ namespace stan {
       virtual void
       write_metric(stan::interface_callbacks::writer::base_writer& writer) {}
 
+      /**
+       * Writes the inverse metric as the key-value pair inv_metric,
+       * for metrics with free parameters.
+       *
+       * @param writer writer callback
+       */
+      virtual void
+      write_inv_metric(stan::interface_callbacks::writer::base_writer&
+                       writer) {}
+
+      /**
+       * Saves the position, momentum, and potential, along with any
+       * adapted metric, in the format of write_chain_state().
+       */
+      virtual void write_state(std::ostream& o) {
+        write_chain_state(o, q);
+        write_chain_state(o, p);
+        write_chain_state(o, V);
+        write_chain_state(o, g);
+      }
+
+      virtual void read_state(std::istream& in) {
+        int n = q.size();
+        read_chain_state(in, q, n);
+        read_chain_state(in, p, n);
+        read_chain_state(in, V);
+        read_chain_state(in, g, n);
+        invalidate_kinetic();
+      }
+
     protected:
       template <typename T>
       static inline void
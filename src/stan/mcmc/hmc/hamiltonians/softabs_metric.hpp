@@ -5,6 +5,7 @@
 
 #include <stan/mcmc/hmc/hamiltonians/base_hamiltonian.hpp>
 #include <stan/mcmc/hmc/hamiltonians/softabs_point.hpp>
+#include <stan/model/count_gradient.hpp>
 
 #include <boost/random/variate_generator.hpp>
 #include <boost/random/normal_distribution.hpp>
@@ -80,20 +81,35 @@ namespace stan {
                    z.eigen_deco.eigenvectors().transpose() * z.p);
       }
 
+      void compute_kinetic(softabs_point& z) {
+        Eigen::VectorXd Qp = z.eigen_deco.eigenvectors().transpose() * z.p;
+        Eigen::VectorXd a = z.softabs_lambda_inv.cwiseProduct(Qp);
+        z.tau = 0.5 * Qp.dot(a);
+        z.p_sharp.noalias() = z.eigen_deco.eigenvectors() * a;
+      }
+
       Eigen::VectorXd dphi_dq(
         softabs_point& z,
         interface_callbacks::writer::base_writer& info_writer,
         interface_callbacks::writer::base_writer& error_writer) {
-          Eigen::VectorXd a
-            = z.softabs_lambda_inv.cwiseProduct(z.pseudo_j.diagonal());
-          Eigen::MatrixXd A =  a.asDiagonal()
-                             * z.eigen_deco.eigenvectors().transpose();
-          Eigen::MatrixXd B = z.eigen_deco.eigenvectors() * A;
-
-          stan::math::grad_tr_mat_times_hessian(
-            softabs_fun<Model>(this->model_, 0), z.q, B, a);
+          // The nested autodiff sweeps only depend on q, which is
+          // shared by the end of one leapfrog step and the start of
+          // the next
+          if (!z.log_det_grad_cached()) {
+            Eigen::VectorXd a
+              = z.softabs_lambda_inv.cwiseProduct(z.pseudo_j.diagonal());
+            Eigen::MatrixXd A =  a.asDiagonal()
+                               * z.eigen_deco.eigenvectors().transpose();
+            Eigen::MatrixXd B = z.eigen_deco.eigenvectors() * A;
+
+            stan::math::grad_tr_mat_times_hessian(
+              softabs_fun<Model>(this->model_, 0), z.q, B, a);
+
+            z.log_det_grad = - 0.5 * a;
+            z.log_det_grad_q = z.q;
+          }
 
-          return - 0.5 * a + z.g;
+          return z.log_det_grad + z.g;
       }
 
       void sample_p(softabs_point& z, BaseRNG& rng) {
@@ -106,6 +122,7 @@ namespace stan {
           a(n) = sqrt(z.softabs_lambda(n)) * rand_unit_gaus();
 
         z.p = z.eigen_deco.eigenvectors() * a;
+        z.invalidate_kinetic();
       }
 
       void init(
@@ -120,6 +137,11 @@ namespace stan {
         softabs_point& z,
         interface_callbacks::writer::base_writer& info_writer,
         interface_callbacks::writer::base_writer& error_writer) {
+        z.log_det_grad_q.resize(0);
+
+        using stan::model::count_gradient;
+        count_gradient(this->model_);
+
         // Compute the Hessian
         stan::math::hessian<double>(
           softabs_fun<Model>(this->model_, 0), z.q, z.V, z.g, z.hessian);
@@ -20,7 +20,9 @@ namespace stan {
         log_det_metric(0),
         softabs_lambda(Eigen::VectorXd::Zero(n)),
         softabs_lambda_inv(Eigen::VectorXd::Zero(n)),
-        pseudo_j(Eigen::MatrixXd::Identity(n, n)) {}
+        pseudo_j(Eigen::MatrixXd::Identity(n, n)),
+        log_det_grad(Eigen::VectorXd::Zero(n)),
+        log_det_grad_q(Eigen::VectorXd::Zero(0)) {}
 
       // SoftAbs regularization parameter
       double alpha;
@@ -40,6 +42,15 @@ namespace stan {
       // Psuedo-Jacobian of the eigenvalues
       Eigen::MatrixXd pseudo_j;
 
+      // Gradient of the log determinant term of phi, which only
+      // depends on q, cached for the position log_det_grad_q
+      Eigen::VectorXd log_det_grad;
+      Eigen::VectorXd log_det_grad_q;
+
+      bool log_det_grad_cached() const {
+        return log_det_grad_q.size() == q.size() && log_det_grad_q == q;
+      }
+
       virtual void
       write_metric(stan::interface_callbacks::writer::base_writer& writer) {
         writer("No free parameters for SoftAbs metric");
@@ -46,6 +46,11 @@ namespace stan {
         return z.p;
       }
 
+      void compute_kinetic(unit_e_point& z) {
+        z.p_sharp = z.p;
+        z.tau = 0.5 * z.p.squaredNorm();
+      }
+
       Eigen::VectorXd dphi_dq(
         unit_e_point& z,
         interface_callbacks::writer::base_writer& info_writer,
@@ -59,6 +64,8 @@ namespace stan {
 
         for (int i = 0; i < z.p.size(); ++i)
           z.p(i) = rand_unit_gaus();
+
+        z.invalidate_kinetic();
       }
     };
 
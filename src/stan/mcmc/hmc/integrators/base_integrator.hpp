@@ -2,6 +2,8 @@
 #define STAN_MCMC_HMC_INTEGRATORS_BASE_INTEGRATOR_HPP
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <string>
+#include <vector>
 
 namespace stan {
   namespace mcmc {
@@ -17,6 +19,22 @@ namespace stan {
              const double epsilon,
              interface_callbacks::writer::base_writer& info_writer,
              interface_callbacks::writer::base_writer& error_writer) = 0;
+
+      /**
+       * Integrators with internal iterations report them as extra
+       * sampler parameters, accumulated since the last reset.
+       */
+      virtual void get_param_names(std::vector<std::string>& names) {}
+
+      virtual void get_params(std::vector<double>& values) {}
+
+      virtual void reset_statistics() {}
+
+      /**
+       * Integrators that solve implicit updates stop them at a
+       * threshold of c |epsilon|^3; the others ignore the scale.
+       */
+      virtual void set_adaptive_threshold_scale(double c) {}
     };
 
   }  // mcmc
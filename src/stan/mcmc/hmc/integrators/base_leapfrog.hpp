@@ -2,30 +2,89 @@
 #define STAN_MCMC_HMC_INTEGRATORS_BASE_LEAPFROG_HPP
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/mcmc/hmc/integrators/base_integrator.hpp>
+#include <stan/mcmc/hmc/integrators/integrator_scheme.hpp>
+#include <stan/mcmc/transition_profile.hpp>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 
 namespace stan {
   namespace mcmc {
 
+    /**
+     * Integrators built from a momentum update, a position update
+     * and a closing momentum update.  Each step of size epsilon
+     * composes these updates following the integrator scheme, by
+     * default a single leapfrog step.
+     *
+     * Every scheme is a palindrome of stages, each of which opens
+     * with begin_update_p and closes with end_update_p, so the step
+     * stays symmetric and symplectic for the implicit generalized
+     * leapfrog as well.  The minimum-error coefficients are derived
+     * for separable Hamiltonians.
+     */
     template <class Hamiltonian>
     class base_leapfrog : public base_integrator<Hamiltonian> {
     public:
       base_leapfrog()
-        : base_integrator<Hamiltonian>() {}
+        : base_integrator<Hamiltonian>(), scheme_(leapfrog_scheme) {}
+
+      void set_scheme(integrator_scheme scheme) {
+        scheme_ = scheme;
+      }
+
+      integrator_scheme get_scheme() const {
+        return scheme_;
+      }
 
       void evolve(typename Hamiltonian::PointType& z,
                   Hamiltonian& hamiltonian,
                   const double epsilon,
                   interface_callbacks::writer::base_writer& info_writer,
                   interface_callbacks::writer::base_writer& error_writer) {
-        begin_update_p(z, hamiltonian, 0.5 * epsilon,
-                       info_writer, error_writer);
-        update_q(z, hamiltonian, epsilon,
+        transition_profile* profile = hamiltonian.get_profile();
+        if (profile) profile->begin(transition_profile::integrator_phase);
+
+        switch (scheme_) {
+        case two_stage_scheme: {
+          const double b = 0.21178;
+          stage_(z, hamiltonian, b * epsilon, 0.5 * epsilon,
+                 (0.5 - b) * epsilon, info_writer, error_writer);
+          stage_(z, hamiltonian, (0.5 - b) * epsilon, 0.5 * epsilon,
+                 b * epsilon, info_writer, error_writer);
+          break;
+        }
+        case three_stage_scheme: {
+          const double a = 0.11888010966548;
+          const double b = 0.29619504261126;
+          const double c = 0.5 * (0.5 - a);
+          stage_(z, hamiltonian, a * epsilon, b * epsilon,
+                 c * epsilon, info_writer, error_writer);
+          stage_(z, hamiltonian, c * epsilon, (1 - 2 * b) * epsilon,
+                 c * epsilon, info_writer, error_writer);
+          stage_(z, hamiltonian, c * epsilon, b * epsilon,
+                 a * epsilon, info_writer, error_writer);
+          break;
+        }
+        case yoshida4_scheme: {
+          const double w1 = 1.0 / (2.0 - std::pow(2.0, 1.0 / 3.0));
+          const double w0 = 1.0 - 2.0 * w1;
+          stage_(z, hamiltonian, 0.5 * w1 * epsilon, w1 * epsilon,
+                 0.5 * w1 * epsilon, info_writer, error_writer);
+          stage_(z, hamiltonian, 0.5 * w0 * epsilon, w0 * epsilon,
+                 0.5 * w0 * epsilon, info_writer, error_writer);
+          stage_(z, hamiltonian, 0.5 * w1 * epsilon, w1 * epsilon,
+                 0.5 * w1 * epsilon, info_writer, error_writer);
+          break;
+        }
+        default:
+          stage_(z, hamiltonian, 0.5 * epsilon, epsilon, 0.5 * epsilon,
                  info_writer, error_writer);
-        end_update_p(z, hamiltonian, 0.5 * epsilon,
-                     info_writer, error_writer);
+        }
+
+        if (profile) profile->end(transition_profile::integrator_phase);
       }
 
       void
@@ -136,6 +195,31 @@ namespace stan {
         Hamiltonian& hamiltonian, double epsilon,
         interface_callbacks::writer::base_writer& info_writer,
         interface_callbacks::writer::base_writer& error_writer) = 0;
+
+    protected:
+      integrator_scheme scheme_;
+
+      void stage_(typename Hamiltonian::PointType& z,
+                  Hamiltonian& hamiltonian,
+                  double begin_epsilon, double q_epsilon, double end_epsilon,
+                  interface_callbacks::writer::base_writer& info_writer,
+                  interface_callbacks::writer::base_writer& error_writer) {
+        begin_update_p(z, hamiltonian, begin_epsilon,
+                       info_writer, error_writer);
+        update_q(z, hamiltonian, q_epsilon, info_writer, error_writer);
+        end_update_p(z, hamiltonian, end_epsilon, info_writer, error_writer);
+      }
+
+      // Velocity dtau/dp of the position updates, timed as the
+      // kinetic phase
+      Eigen::VectorXd dtau_dp_(typename Hamiltonian::PointType& z,
+                               Hamiltonian& hamiltonian) {
+        transition_profile* profile = hamiltonian.get_profile();
+        if (profile) profile->begin(transition_profile::kinetic_phase);
+        Eigen::VectorXd v = hamiltonian.dtau_dp(z);
+        if (profile) profile->end(transition_profile::kinetic_phase);
+        return v;
+      }
     };
 
   }  // mcmc
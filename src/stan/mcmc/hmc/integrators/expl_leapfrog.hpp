@@ -19,13 +19,15 @@ namespace stan {
         interface_callbacks::writer::base_writer& info_writer,
         interface_callbacks::writer::base_writer& error_writer) {
         z.p -= epsilon * hamiltonian.dphi_dq(z, info_writer, error_writer);
+        z.invalidate_kinetic();
       }
 
       void update_q(typename Hamiltonian::PointType& z,
                     Hamiltonian& hamiltonian, double epsilon,
                     interface_callbacks::writer::base_writer& info_writer,
                     interface_callbacks::writer::base_writer& error_writer) {
-        z.q += epsilon * hamiltonian.dtau_dp(z);
+        z.q += epsilon * this->dtau_dp_(z, hamiltonian);
+        z.invalidate_kinetic();
         hamiltonian.update_potential_gradient(z, info_writer, error_writer);
       }
 
@@ -35,6 +37,7 @@ namespace stan {
         interface_callbacks::writer::base_writer& info_writer,
         interface_callbacks::writer::base_writer& error_writer) {
         z.p -= epsilon * hamiltonian.dphi_dq(z, info_writer, error_writer);
+        z.invalidate_kinetic();
       }
     };
 
@@ -3,16 +3,35 @@
 
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/mcmc/hmc/integrators/base_leapfrog.hpp>
+#include <cmath>
+#include <string>
+#include <vector>
 
 namespace stan {
   namespace mcmc {
 
+    /**
+     * Generalized leapfrog for non-separable Hamiltonians, solving
+     * the implicit updates by fixed point iteration.
+     *
+     * The iterations stop once no coordinate changes by more than
+     * the fixed point threshold.  With a nonzero adaptive threshold
+     * scale c, a half step of size epsilon stops at the larger of
+     * the threshold and c |epsilon|^3, as solving much below the
+     * O(epsilon^3) local error of the integrator only costs
+     * gradients.  The iterations of the implicit updates and the
+     * updates that hit the iteration limit without converging are
+     * counted and reported as sampler parameters.
+     */
     template <typename Hamiltonian>
     class impl_leapfrog: public base_leapfrog<Hamiltonian> {
     public:
       impl_leapfrog(): base_leapfrog<Hamiltonian>(),
                        max_num_fixed_point_(10),
-                       fixed_point_threshold_(1e-8) {}
+                       fixed_point_threshold_(1e-8),
+                       adaptive_threshold_scale_(0),
+                       num_fixed_point_(0),
+                       num_fixed_point_fail_(0) {}
 
       void begin_update_p(
         typename Hamiltonian::PointType& z,
@@ -21,8 +40,11 @@ namespace stan {
         interface_callbacks::writer::base_writer& info_writer,
         interface_callbacks::writer::base_writer& error_writer) {
         hat_phi(z, hamiltonian, epsilon, info_writer, error_writer);
-        hat_tau(z, hamiltonian, epsilon, this->max_num_fixed_point_,
-                info_writer, error_writer);
+        bool converged = false;
+        int n = fixed_point_tau_(z, hamiltonian, epsilon,
+                                 this->max_num_fixed_point_, converged,
+                                 info_writer, error_writer);
+        record_fixed_point_(n, converged);
       }
 
       void update_q(typename Hamiltonian::PointType& z,
@@ -31,18 +53,25 @@ namespace stan {
                     interface_callbacks::writer::base_writer& info_writer,
                     interface_callbacks::writer::base_writer& error_writer) {
         // hat{T} = dT/dp * d/dq
-        Eigen::VectorXd q_init = z.q + 0.5 * epsilon * hamiltonian.dtau_dp(z);
-        Eigen::VectorXd delta_q(z.q.size());
-
-        for (int n = 0; n < this->max_num_fixed_point_; ++n) {
-          delta_q = z.q;
-          z.q.noalias() = q_init + 0.5 * epsilon * hamiltonian.dtau_dp(z);
+        q_init_ = z.q;
+        q_init_ += 0.5 * epsilon * this->dtau_dp_(z, hamiltonian);
+        double threshold = threshold_(epsilon);
+
+        int n = 0;
+        bool converged = false;
+        while (!converged && n < this->max_num_fixed_point_) {
+          ++n;
+          delta_ = z.q;
+          z.q.noalias() = q_init_
+                          + 0.5 * epsilon * this->dtau_dp_(z, hamiltonian);
           hamiltonian.update_metric(z, info_writer, error_writer);
 
-          delta_q -= z.q;
-          if (delta_q.cwiseAbs().maxCoeff() < this->fixed_point_threshold_)
-            break;
+          delta_ -= z.q;
+          converged = delta_.cwiseAbs().maxCoeff() < threshold;
         }
+        record_fixed_point_(n, converged);
+
+        z.invalidate_kinetic();
         hamiltonian.update_gradients(z, info_writer, error_writer);
       }
 
@@ -63,6 +92,7 @@ namespace stan {
                    interface_callbacks::writer::base_writer& info_writer,
                    interface_callbacks::writer::base_writer& error_writer) {
         z.p -= epsilon * hamiltonian.dphi_dq(z, info_writer, error_writer);
+        z.invalidate_kinetic();
       }
 
       // hat{tau} = dtau/dq * d/dp
@@ -72,18 +102,9 @@ namespace stan {
                    int num_fixed_point,
                    interface_callbacks::writer::base_writer& info_writer,
                    interface_callbacks::writer::base_writer& error_writer) {
-        Eigen::VectorXd p_init = z.p;
-        Eigen::VectorXd delta_p(z.p.size());
-
-        for (int n = 0; n < num_fixed_point; ++n) {
-          delta_p = z.p;
-          z.p.noalias() = p_init
-                          - epsilon
-                          * hamiltonian.dtau_dq(z, info_writer, error_writer);
-          delta_p -= z.p;
-          if (delta_p.cwiseAbs().maxCoeff() < this->fixed_point_threshold_)
-            break;
-        }
+        bool converged = false;
+        fixed_point_tau_(z, hamiltonian, epsilon, num_fixed_point, converged,
+                         info_writer, error_writer);
       }
 
       int max_num_fixed_point() {
@@ -102,9 +123,89 @@ namespace stan {
         if (t > 0) this->fixed_point_threshold_ = t;
       }
 
+      double adaptive_threshold_scale() {
+        return this->adaptive_threshold_scale_;
+      }
+
+      void set_adaptive_threshold_scale(double c) {
+        if (c >= 0) this->adaptive_threshold_scale_ = c;
+      }
+
+      long num_fixed_point() {
+        return this->num_fixed_point_;
+      }
+
+      long num_fixed_point_fail() {
+        return this->num_fixed_point_fail_;
+      }
+
+      void get_param_names(std::vector<std::string>& names) {
+        names.push_back("n_fixed_point__");
+        names.push_back("n_fixed_point_fail__");
+      }
+
+      void get_params(std::vector<double>& values) {
+        values.push_back(this->num_fixed_point_);
+        values.push_back(this->num_fixed_point_fail_);
+      }
+
+      void reset_statistics() {
+        this->num_fixed_point_ = 0;
+        this->num_fixed_point_fail_ = 0;
+      }
+
     private:
       int max_num_fixed_point_;
       double fixed_point_threshold_;
+      double adaptive_threshold_scale_;
+
+      long num_fixed_point_;
+      long num_fixed_point_fail_;
+
+      // Workspace reused across steps
+      Eigen::VectorXd q_init_;
+      Eigen::VectorXd p_init_;
+      Eigen::VectorXd delta_;
+
+      double threshold_(double epsilon) {
+        double t = this->adaptive_threshold_scale_
+                   * std::fabs(epsilon * epsilon * epsilon);
+        return t > this->fixed_point_threshold_
+               ? t : this->fixed_point_threshold_;
+      }
+
+      // Returns the number of iterations taken
+      int fixed_point_tau_(
+        typename Hamiltonian::PointType& z,
+        Hamiltonian& hamiltonian,
+        double epsilon,
+        int num_fixed_point,
+        bool& converged,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        p_init_ = z.p;
+        double threshold = threshold_(epsilon);
+
+        int n = 0;
+        converged = false;
+        while (!converged && n < num_fixed_point) {
+          ++n;
+          delta_ = z.p;
+          z.p.noalias() = p_init_
+                          - epsilon
+                          * hamiltonian.dtau_dq(z, info_writer, error_writer);
+          delta_ -= z.p;
+          converged = delta_.cwiseAbs().maxCoeff() < threshold;
+        }
+        z.invalidate_kinetic();
+        return n;
+      }
+
+      void record_fixed_point_(int n, bool converged) {
+        this->num_fixed_point_ += n;
+        if (!converged)
+          ++this->num_fixed_point_fail_;
+      }
     };
 
   }  // mcmc
@@ -0,0 +1,62 @@
+#ifndef STAN_MCMC_HMC_INTEGRATORS_INTEGRATOR_SCHEME_HPP
+#define STAN_MCMC_HMC_INTEGRATORS_INTEGRATOR_SCHEME_HPP
+
+#include <stdexcept>
+#include <string>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Symmetric splitting schemes composed by base_leapfrog from
+     * its momentum and position updates, with the number of
+     * gradients per step.
+     *
+     * leapfrog: the Stormer-Verlet step, 1 gradient.
+     * two_stage: minimum-error two-stage splitting of Blanes, Casas
+     *   and Sanz-Serna (2014), 2 gradients.
+     * three_stage: minimum-error three-stage splitting of the same
+     *   authors, 3 gradients.
+     * yoshida4: fourth-order composition of three leapfrog steps
+     *   (Yoshida, 1990), 3 gradients.
+     */
+    enum integrator_scheme {
+      leapfrog_scheme,
+      two_stage_scheme,
+      three_stage_scheme,
+      yoshida4_scheme
+    };
+
+    inline std::string integrator_scheme_name(integrator_scheme s) {
+      switch (s) {
+      case two_stage_scheme:
+        return "two_stage";
+      case three_stage_scheme:
+        return "three_stage";
+      case yoshida4_scheme:
+        return "yoshida4";
+      default:
+        return "leapfrog";
+      }
+    }
+
+    inline integrator_scheme
+    integrator_scheme_from_name(const std::string& name) {
+      if (name == "leapfrog")
+        return leapfrog_scheme;
+      if (name == "two_stage")
+        return two_stage_scheme;
+      if (name == "three_stage")
+        return three_stage_scheme;
+      if (name == "yoshida4")
+        return yoshida4_scheme;
+      throw std::invalid_argument("Unknown integrator " + name);
+    }
+
+    inline int integrator_scheme_stages(integrator_scheme s) {
+      return s == leapfrog_scheme ? 1 : (s == two_stage_scheme ? 2 : 3);
+    }
+
+  }  // mcmc
+}  // stan
+#endif
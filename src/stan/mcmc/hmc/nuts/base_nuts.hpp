@@ -24,14 +24,22 @@ namespace stan {
       base_nuts(const Model& model, BaseRNG& rng)
         : base_hmc<Model, Hamiltonian, Integrator, BaseRNG>(model, rng),
           depth_(0), max_depth_(5), max_deltaH_(1000),
-          n_leapfrog_(0), divergent_(0), energy_(0) {
+          n_leapfrog_(0), divergent_(0), energy_(0),
+          z_plus_(model.num_params_r()), z_minus_(model.num_params_r()),
+          z_sample_(model.num_params_r()), z_propose_(model.num_params_r()),
+          p_sharp_plus_(model.num_params_r()),
+          p_sharp_minus_(model.num_params_r()),
+          rho_(model.num_params_r()), rho_subtree_(model.num_params_r()) {
+        resize_workspace_(max_depth_);
       }
 
       ~base_nuts() {}
 
       void set_max_depth(int d) {
-        if (d > 0)
+        if (d > 0) {
           max_depth_ = d;
+          resize_workspace_(max_depth_);
+        }
       }
 
       void set_max_delta(double d) {
@@ -47,24 +55,28 @@ namespace stan {
                  interface_callbacks::writer::base_writer& error_writer) {
         // Initialize the algorithm
         this->sample_stepsize();
+        this->integrator_.reset_statistics();
 
         this->seed(init_sample.cont_params());
 
-        this->hamiltonian_.sample_p(this->z_, this->rand_int_);
+        this->sample_momentum_();
         this->hamiltonian_.init(this->z_, info_writer, error_writer);
 
-        ps_point z_plus(this->z_);
-        ps_point z_minus(z_plus);
+        this->hamiltonian_.update_kinetic(this->z_);
+
+        z_plus_ = this->z_;
+        z_minus_ = z_plus_;
+
+        z_sample_ = z_plus_;
+        z_propose_ = z_plus_;
 
-        ps_point z_sample(z_plus);
-        ps_point z_propose(z_plus);
+        double H0 = this->hamiltonian_.H_cached(this->z_);
 
-        Eigen::VectorXd p_sharp_plus = this->hamiltonian_.dtau_dp(this->z_);
-        Eigen::VectorXd p_sharp_minus = this->hamiltonian_.dtau_dp(this->z_);
-        Eigen::VectorXd rho = this->z_.p;
+        p_sharp_plus_ = this->z_.p_sharp;
+        p_sharp_minus_ = p_sharp_plus_;
+        rho_ = this->z_.p;
         double log_sum_weight = 0;  // log(exp(H0 - H0))
 
-        double H0 = this->hamiltonian_.H(this->z_);
         int n_leapfrog = 0;
         double sum_metro_prob = 1;  // exp(H0 - H0)
 
@@ -74,31 +86,32 @@ namespace stan {
 
         while (this->depth_ < this->max_depth_) {
           // Build a new subtree in a random direction
-          Eigen::VectorXd rho_subtree(rho.size());
-          rho_subtree.setZero();
+          rho_subtree_.setZero();
 
           bool valid_subtree = false;
           double log_sum_weight_subtree
             = -std::numeric_limits<double>::infinity();
 
           if (this->rand_uniform_() > 0.5) {
-            this->z_.ps_point::operator=(z_plus);
+            this->z_.ps_point::operator=(z_plus_);
             valid_subtree
-              = build_tree(this->depth_, rho_subtree, z_propose,
+              = build_tree(this->depth_, rho_subtree_, z_propose_,
                            H0, 1, n_leapfrog,
                            log_sum_weight_subtree, sum_metro_prob,
                            info_writer, error_writer);
-            z_plus.ps_point::operator=(this->z_);
-            p_sharp_plus = this->hamiltonian_.dtau_dp(this->z_);
+            this->hamiltonian_.update_kinetic(this->z_);
+            z_plus_ = this->z_;
+            p_sharp_plus_ = this->z_.p_sharp;
           } else {
-            this->z_.ps_point::operator=(z_minus);
+            this->z_.ps_point::operator=(z_minus_);
             valid_subtree
-              = build_tree(this->depth_, rho_subtree, z_propose,
+              = build_tree(this->depth_, rho_subtree_, z_propose_,
                            H0, -1, n_leapfrog,
                            log_sum_weight_subtree, sum_metro_prob,
                            info_writer, error_writer);
-            z_minus.ps_point::operator=(this->z_);
-            p_sharp_minus = this->hamiltonian_.dtau_dp(this->z_);
+            this->hamiltonian_.update_kinetic(this->z_);
+            z_minus_ = this->z_;
+            p_sharp_minus_ = this->z_.p_sharp;
           }
 
           if (!valid_subtree) break;
@@ -107,20 +120,20 @@ namespace stan {
           ++(this->depth_);
 
           if (log_sum_weight_subtree > log_sum_weight) {
-            z_sample = z_propose;
+            z_sample_ = z_propose_;
           } else {
             double accept_prob
               = std::exp(log_sum_weight_subtree - log_sum_weight);
             if (this->rand_uniform_() < accept_prob)
-              z_sample = z_propose;
+              z_sample_ = z_propose_;
           }
 
           log_sum_weight
             = math::log_sum_exp(log_sum_weight, log_sum_weight_subtree);
 
           // Break when NUTS criterion is not longer satisfied
-          rho += rho_subtree;
-          if (!compute_criterion(p_sharp_minus, p_sharp_plus, rho))
+          rho_ += rho_subtree_;
+          if (!compute_criterion(p_sharp_minus_, p_sharp_plus_, rho_))
             break;
         }
 
@@ -131,8 +144,8 @@ namespace stan {
         double accept_prob
           = sum_metro_prob / static_cast<double>(n_leapfrog + 1);
 
-        this->z_.ps_point::operator=(z_sample);
-        this->energy_ = this->hamiltonian_.H(this->z_);
+        this->z_.ps_point::operator=(z_sample_);
+        this->energy_ = this->hamiltonian_.H_cached(this->z_);
         return sample(this->z_.q, -this->z_.V, accept_prob);
       }
 
@@ -142,6 +155,7 @@ namespace stan {
         names.push_back("n_leapfrog__");
         names.push_back("divergent__");
         names.push_back("energy__");
+        this->integrator_.get_param_names(names);
       }
 
       void get_sampler_params(std::vector<double>& values) {
@@ -150,6 +164,7 @@ namespace stan {
         values.push_back(this->n_leapfrog_);
         values.push_back(this->divergent_);
         values.push_back(this->energy_);
+        this->integrator_.get_params(values);
       }
 
       bool compute_criterion(Eigen::VectorXd& p_sharp_minus,
@@ -187,7 +202,7 @@ namespace stan {
                                    info_writer, error_writer);
           ++n_leapfrog;
 
-          double h = this->hamiltonian_.H(this->z_);
+          double h = this->hamiltonian_.H_cached(this->z_);
           if (boost::math::isnan(h))
             h = std::numeric_limits<double>::infinity();
 
@@ -206,9 +221,14 @@ namespace stan {
           return !this->divergent_;
         }
         // General recursion
-        Eigen::VectorXd p_sharp_left = this->hamiltonian_.dtau_dp(this->z_);
+        if (depth >= static_cast<int>(rho_subtree_depth_.size()))
+          resize_workspace_(depth + 1);
 
-        Eigen::VectorXd rho_subtree(rho.size());
+        this->hamiltonian_.update_kinetic(this->z_);
+        Eigen::VectorXd& p_sharp_left = p_sharp_left_depth_[depth];
+        p_sharp_left = this->z_.p_sharp;
+
+        Eigen::VectorXd& rho_subtree = rho_subtree_depth_[depth];
         rho_subtree.setZero();
 
         // Build the left subtree
@@ -223,7 +243,8 @@ namespace stan {
         if (!valid_left) return false;
 
         // Build the right subtree
-        ps_point z_propose_right(this->z_);
+        ps_point& z_propose_right = z_propose_right_depth_[depth];
+        z_propose_right = this->z_;
         double log_sum_weight_right = -std::numeric_limits<double>::infinity();
 
         bool valid_right
@@ -250,7 +271,9 @@ namespace stan {
         }
 
         rho += rho_subtree;
-        Eigen::VectorXd p_sharp_right = this->hamiltonian_.dtau_dp(this->z_);
+        this->hamiltonian_.update_kinetic(this->z_);
+        Eigen::VectorXd& p_sharp_right = p_sharp_right_depth_[depth];
+        p_sharp_right = this->z_.p_sharp;
         return compute_criterion(p_sharp_left, p_sharp_right, rho_subtree);
       }
 
@@ -261,6 +284,41 @@ namespace stan {
       int n_leapfrog_;
       int divergent_;
       double energy_;
+
+    protected:
+      // Trajectory workspace, allocated once and reused across
+      // transitions so that steady-state sampling does not allocate
+      ps_point z_plus_;
+      ps_point z_minus_;
+      ps_point z_sample_;
+      ps_point z_propose_;
+
+      Eigen::VectorXd p_sharp_plus_;
+      Eigen::VectorXd p_sharp_minus_;
+      Eigen::VectorXd rho_;
+      Eigen::VectorXd rho_subtree_;
+
+      // Per-depth storage for build_tree, indexed by subtree depth
+      std::vector<Eigen::VectorXd> rho_subtree_depth_;
+      std::vector<Eigen::VectorXd> p_sharp_left_depth_;
+      std::vector<Eigen::VectorXd> p_sharp_right_depth_;
+      std::vector<ps_point> z_propose_right_depth_;
+
+      /**
+       * Sizes the per-depth workspace to hold subtrees of
+       * depth up to n_depth - 1.  Existing storage is kept.
+       *
+       * @param n_depth Number of subtree depths to support
+       */
+      void resize_workspace_(int n_depth) {
+        if (n_depth <= static_cast<int>(rho_subtree_depth_.size()))
+          return;
+        int n = rho_.size();
+        rho_subtree_depth_.resize(n_depth, Eigen::VectorXd::Zero(n));
+        p_sharp_left_depth_.resize(n_depth, Eigen::VectorXd::Zero(n));
+        p_sharp_right_depth_.resize(n_depth, Eigen::VectorXd::Zero(n));
+        z_propose_right_depth_.resize(n_depth, ps_point(n));
+      }
     };
 
   }  // mcmc
@@ -59,12 +59,13 @@ namespace stan {
                  interface_callbacks::writer::base_writer& error_writer) {
         // Initialize the algorithm
         this->sample_stepsize();
+        this->integrator_.reset_statistics();
 
         nuts_util util;
 
         this->seed(init_sample.cont_params());
 
-        this->hamiltonian_.sample_p(this->z_, this->rand_int_);
+        this->sample_momentum_();
         this->hamiltonian_.init(this->z_, info_writer, error_writer);
 
         ps_point z_plus(this->z_);
@@ -158,6 +159,7 @@ namespace stan {
         names.push_back("n_leapfrog__");
         names.push_back("divergent__");
         names.push_back("energy__");
+        this->integrator_.get_param_names(names);
       }
 
       void get_sampler_params(std::vector<double>& values) {
@@ -166,6 +168,7 @@ namespace stan {
         values.push_back(this->n_leapfrog_);
         values.push_back(this->divergent_);
         values.push_back(this->energy_);
+        this->integrator_.get_params(values);
       }
 
       virtual bool compute_criterion(ps_point& start,
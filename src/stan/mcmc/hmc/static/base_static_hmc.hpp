@@ -36,22 +36,23 @@ namespace stan {
                  interface_callbacks::writer::base_writer& info_writer,
                  interface_callbacks::writer::base_writer& error_writer) {
         this->sample_stepsize();
+        this->integrator_.reset_statistics();
 
         this->seed(init_sample.cont_params());
 
-        this->hamiltonian_.sample_p(this->z_, this->rand_int_);
+        this->sample_momentum_();
         this->hamiltonian_.init(this->z_, info_writer, error_writer);
 
         ps_point z_init(this->z_);
 
-        double H0 = this->hamiltonian_.H(this->z_);
+        double H0 = this->hamiltonian_.H_cached(this->z_);
 
         for (int i = 0; i < L_; ++i)
           this->integrator_.evolve(this->z_, this->hamiltonian_,
                                    this->epsilon_,
                                    info_writer, error_writer);
 
-        double h = this->hamiltonian_.H(this->z_);
+        double h = this->hamiltonian_.H_cached(this->z_);
         if (boost::math::isnan(h)) h = std::numeric_limits<double>::infinity();
 
         double acceptProb = std::exp(H0 - h);
@@ -61,7 +62,7 @@ namespace stan {
 
         acceptProb = acceptProb > 1 ? 1 : acceptProb;
 
-        this->energy_ = this->hamiltonian_.H(this->z_);
+        this->energy_ = this->hamiltonian_.H_cached(this->z_);
         return sample(this->z_.q, - this->hamiltonian_.V(this->z_), acceptProb);
       }
 
@@ -69,12 +70,14 @@ namespace stan {
         names.push_back("stepsize__");
         names.push_back("int_time__");
         names.push_back("energy__");
+        this->integrator_.get_param_names(names);
       }
 
       void get_sampler_params(std::vector<double>& values) {
         values.push_back(this->epsilon_);
         values.push_back(this->T_);
         values.push_back(this->energy_);
+        this->integrator_.get_params(values);
       }
 
       void set_nominal_stepsize_and_T(const double e, const double t) {
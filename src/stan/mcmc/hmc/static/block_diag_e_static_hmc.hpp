@@ -0,0 +1,258 @@
+#ifndef STAN_MCMC_HMC_STATIC_BLOCK_DIAG_E_STATIC_HMC_HPP
+#define STAN_MCMC_HMC_STATIC_BLOCK_DIAG_E_STATIC_HMC_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/model/util.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_01.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Hamiltonian Monte Carlo using the endpoint of trajectories
+     * with a static integration time and a diagonal Euclidean
+     * metric, advancing a block of K independent chains in lockstep.
+     *
+     * Positions, momenta and potential gradients of the chains are
+     * the columns of D x K matrices, so each leapfrog half step is
+     * a single matrix update with no virtual dispatch; only the
+     * model gradients are evaluated chain by chain.  All chains
+     * share the step size, integration time and inverse metric,
+     * which defaults to the identity (a unit metric).
+     *
+     * With K = 1 the random numbers are consumed in the same order
+     * as diag_e_static_hmc, so both produce the same draws.
+     *
+     * This is a transition kernel only: it is not a base_mcmc, has
+     * no step size or metric adaptation and is not hooked into the
+     * services, so the caller sets the step size and inverse metric
+     * and drives transition() directly.
+     */
+    template <class Model, class BaseRNG>
+    class block_diag_e_static_hmc {
+    public:
+      block_diag_e_static_hmc(const Model& model, BaseRNG& rng,
+                              int num_chains)
+        : model_(model),
+          rand_int_(rng),
+          rand_uniform_(rand_int_),
+          mInv_(Eigen::VectorXd::Ones(model.num_params_r())),
+          q_(model.num_params_r(), num_chains),
+          p_(model.num_params_r(), num_chains),
+          g_(model.num_params_r(), num_chains),
+          V_(num_chains),
+          q_init_(model.num_params_r(), num_chains),
+          g_init_(model.num_params_r(), num_chains),
+          V_init_(num_chains),
+          H0_(num_chains),
+          accept_stat_(num_chains),
+          energy_(num_chains),
+          nom_epsilon_(0.1),
+          epsilon_(nom_epsilon_),
+          epsilon_jitter_(0.0),
+          T_(1) {
+        update_L_();
+      }
+
+      /**
+       * Advances every chain by one transition.
+       *
+       * @param[in,out] q Unconstrained positions, one chain per column
+       * @param info_writer Writer for information messages
+       * @param error_writer Writer for error messages
+       */
+      void transition(Eigen::MatrixXd& q,
+                      interface_callbacks::writer::base_writer& info_writer,
+                      interface_callbacks::writer::base_writer& error_writer) {
+        sample_stepsize();
+
+        q_ = q;
+        sample_p_();
+        update_potential_gradients_(info_writer, error_writer);
+
+        q_init_ = q_;
+        g_init_ = g_;
+        V_init_ = V_;
+        H0_ = hamiltonians_();
+
+        for (int i = 0; i < L_; ++i) {
+          p_ -= (0.5 * epsilon_) * g_;
+          q_.noalias() += epsilon_ * (mInv_.asDiagonal() * p_);
+          update_potential_gradients_(info_writer, error_writer);
+          p_ -= (0.5 * epsilon_) * g_;
+        }
+
+        Eigen::VectorXd h = hamiltonians_();
+
+        for (int k = 0; k < num_chains(); ++k) {
+          if (boost::math::isnan(h(k)))
+            h(k) = std::numeric_limits<double>::infinity();
+
+          double accept_prob = std::exp(H0_(k) - h(k));
+
+          if (accept_prob < 1 && rand_uniform_() > accept_prob) {
+            q_.col(k) = q_init_.col(k);
+            g_.col(k) = g_init_.col(k);
+            V_(k) = V_init_(k);
+            energy_(k) = H0_(k);
+          } else {
+            energy_(k) = h(k);
+          }
+
+          accept_stat_(k) = accept_prob > 1 ? 1 : accept_prob;
+        }
+
+        q = q_;
+      }
+
+      int num_chains() const {
+        return static_cast<int>(V_.size());
+      }
+
+      /**
+       * Log density of each chain after the last transition.
+       */
+      Eigen::VectorXd log_prob() const {
+        return -V_;
+      }
+
+      const Eigen::VectorXd& accept_stat() const {
+        return accept_stat_;
+      }
+
+      const Eigen::VectorXd& energy() const {
+        return energy_;
+      }
+
+      Eigen::VectorXd& inv_e_metric() {
+        return mInv_;
+      }
+
+      void set_nominal_stepsize_and_T(const double e, const double t) {
+        if (e > 0 && t > 0) {
+          nom_epsilon_ = e;
+          T_ = t;
+          update_L_();
+        }
+      }
+
+      void set_nominal_stepsize_and_L(const double e, const int l) {
+        if (e > 0 && l > 0) {
+          nom_epsilon_ = e;
+          L_ = l;
+          T_ = nom_epsilon_ * L_;
+        }
+      }
+
+      void set_stepsize_jitter(double j) {
+        if (j > 0 && j < 1)
+          epsilon_jitter_ = j;
+      }
+
+      double get_nominal_stepsize() {
+        return nom_epsilon_;
+      }
+
+      double get_current_stepsize() {
+        return epsilon_;
+      }
+
+      double get_T() {
+        return T_;
+      }
+
+      int get_L() {
+        return L_;
+      }
+
+      void sample_stepsize() {
+        epsilon_ = nom_epsilon_;
+        if (epsilon_jitter_)
+          epsilon_ *= 1.0 + epsilon_jitter_ * (2.0 * rand_uniform_() - 1.0);
+      }
+
+    protected:
+      const Model& model_;
+
+      BaseRNG& rand_int_;
+
+      // Uniform(0, 1) RNG
+      boost::uniform_01<BaseRNG&> rand_uniform_;
+
+      Eigen::VectorXd mInv_;
+
+      // Current state of the chains, one per column; g_ and V_ are
+      // the gradient and value of the potential -log p(q)
+      Eigen::MatrixXd q_;
+      Eigen::MatrixXd p_;
+      Eigen::MatrixXd g_;
+      Eigen::VectorXd V_;
+
+      // State at the start of the trajectory, restored on rejection
+      Eigen::MatrixXd q_init_;
+      Eigen::MatrixXd g_init_;
+      Eigen::VectorXd V_init_;
+      Eigen::VectorXd H0_;
+
+      Eigen::VectorXd accept_stat_;
+      Eigen::VectorXd energy_;
+
+      double nom_epsilon_;
+      double epsilon_;
+      double epsilon_jitter_;
+      double T_;
+      int L_;
+
+      void update_L_() {
+        L_ = static_cast<int>(T_ / nom_epsilon_);
+        L_ = L_ < 1 ? 1 : L_;
+      }
+
+      void sample_p_() {
+        for (int k = 0; k < num_chains(); ++k) {
+          boost::variate_generator<BaseRNG&, boost::normal_distribution<> >
+            rand_diag_gaus(rand_int_, boost::normal_distribution<>());
+
+          for (int i = 0; i < p_.rows(); ++i)
+            p_(i, k) = rand_diag_gaus() / sqrt(mInv_(i));
+        }
+      }
+
+      Eigen::VectorXd hamiltonians_() {
+        Eigen::VectorXd H(num_chains());
+        for (int k = 0; k < num_chains(); ++k)
+          H(k) = 0.5 * p_.col(k).dot(mInv_.cwiseProduct(p_.col(k))) + V_(k);
+        return H;
+      }
+
+      void update_potential_gradients_(
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer) {
+        Eigen::VectorXd q_k(q_.rows());
+        Eigen::VectorXd g_k(q_.rows());
+        for (int k = 0; k < num_chains(); ++k) {
+          q_k = q_.col(k);
+          try {
+            stan::model::gradient(model_, q_k, V_(k), g_k, info_writer);
+            V_(k) = -V_(k);
+          } catch (const std::exception& e) {
+            error_writer("Informational Message: The current Metropolis "
+                         "proposal is about to be rejected because of the "
+                         "following issue:");
+            error_writer(e.what());
+            V_(k) = std::numeric_limits<double>::infinity();
+          }
+          g_.col(k) = -g_k;
+        }
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
@@ -39,8 +39,15 @@ namespace stan {
           bool update = this->var_adaptation_.learn_variance(this->z_.mInv,
                                                              this->z_.q);
           if (update) {
+            bool pooled
+              = this->stepsize_adaptation_.pool_stepsize(this->nom_epsilon_);
+            double epsilon = this->nom_epsilon_;
             this->init_stepsize(info_writer, error_writer);
-            this->stepsize_adaptation_.set_mu(log(10 * this->nom_epsilon_));
+
+            // Center the next window on the pooled step size
+            if (!pooled)
+              epsilon = this->nom_epsilon_;
+            this->stepsize_adaptation_.set_mu(log(10 * epsilon));
             this->stepsize_adaptation_.restart();
           }
         }
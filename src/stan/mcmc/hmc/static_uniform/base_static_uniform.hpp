@@ -38,14 +38,15 @@ namespace stan {
                  interface_callbacks::writer::base_writer& info_writer,
                  interface_callbacks::writer::base_writer& error_writer) {
         this->sample_stepsize();
+        this->integrator_.reset_statistics();
 
         this->seed(init_sample.cont_params());
 
-        this->hamiltonian_.sample_p(this->z_, this->rand_int_);
+        this->sample_momentum_();
         this->hamiltonian_.init(this->z_, info_writer, error_writer);
 
         ps_point z_init(this->z_);
-        double H0 = this->hamiltonian_.H(this->z_);
+        double H0 = this->hamiltonian_.H_cached(this->z_);
 
         ps_point z_sample(this->z_);
         double sum_prob = 1;
@@ -59,7 +60,7 @@ namespace stan {
                                    -this->epsilon_,
                                    info_writer, error_writer);
 
-          double h = this->hamiltonian_.H(this->z_);
+          double h = this->hamiltonian_.H_cached(this->z_);
           if (boost::math::isnan(h))
             h = std::numeric_limits<double>::infinity();
 
@@ -78,7 +79,7 @@ namespace stan {
                                    this->epsilon_,
                                    info_writer, error_writer);
 
-          double h = this->hamiltonian_.H(this->z_);
+          double h = this->hamiltonian_.H_cached(this->z_);
           if (boost::math::isnan(h))
             h = std::numeric_limits<double>::infinity();
 
@@ -93,7 +94,7 @@ namespace stan {
         double accept_prob = sum_metro_prob / static_cast<double>(L_);
 
         this->z_.ps_point::operator=(z_sample);
-        this->energy_ = this->hamiltonian_.H(this->z_);
+        this->energy_ = this->hamiltonian_.H_cached(this->z_);
         return sample(this->z_.q,
                       - this->hamiltonian_.V(this->z_),
                       accept_prob);
@@ -103,12 +104,14 @@ namespace stan {
         names.push_back("stepsize__");
         names.push_back("int_time__");
         names.push_back("energy__");
+        this->integrator_.get_param_names(names);
       }
 
       void get_sampler_params(std::vector<double>& values) {
         values.push_back(this->epsilon_);
         values.push_back(this->T_);
         values.push_back(this->energy_);
+        this->integrator_.get_params(values);
       }
 
       void set_nominal_stepsize_and_T(const double e, const double t) {
@@ -0,0 +1,82 @@
+#ifndef STAN_MCMC_HMC_XHMC_ADAPT_BLOCK_DENSE_E_XHMC_HPP
+#define STAN_MCMC_HMC_XHMC_ADAPT_BLOCK_DENSE_E_XHMC_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/mcmc/stepsize_block_covar_adapter.hpp>
+#include <stan/mcmc/hmc/xhmc/block_dense_e_xhmc.hpp>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Exhausive Hamiltonian Monte Carlo (XHMC) with multinomial sampling
+     * with a Gaussian-Euclidean disintegration and adaptive
+     * block-diagonal metric and adaptive step size
+     */
+    template <class Model, class BaseRNG>
+    class adapt_block_dense_e_xhmc
+      : public block_dense_e_xhmc<Model, BaseRNG>,
+        public stepsize_block_covar_adapter {
+    public:
+      adapt_block_dense_e_xhmc(const Model& model, BaseRNG& rng)
+        : block_dense_e_xhmc<Model, BaseRNG>(model, rng),
+          stepsize_block_covar_adapter(model.num_params_r()) {}
+
+      /**
+       * Sets the partition of the metric into blocks of consecutive
+       * parameters and resets the metric to the identity.
+       *
+       * @param sizes Sizes of the blocks
+       * @throw std::invalid_argument if the sizes do not cover the
+       *   parameters
+       */
+      void set_blocks(const std::vector<int>& sizes) {
+        this->z_.set_blocks(sizes);
+        this->block_covar_adaptation_.set_blocks(sizes);
+      }
+
+      ~adapt_block_dense_e_xhmc() {}
+
+      sample
+      transition(sample& init_sample,
+                 interface_callbacks::writer::base_writer& info_writer,
+                 interface_callbacks::writer::base_writer& error_writer) {
+        sample s
+          = block_dense_e_xhmc<Model, BaseRNG>::transition(init_sample,
+                                                            info_writer,
+                                                            error_writer);
+
+        if (this->adapt_flag_) {
+          this->stepsize_adaptation_.learn_stepsize(this->nom_epsilon_,
+                                                    s.accept_stat());
+
+          bool update
+            = this->block_covar_adaptation_.learn_covariance(this->z_.mInv,
+                                                             this->z_.q);
+
+          if (update) {
+            this->z_.update_mInv_factor();
+            bool pooled
+              = this->stepsize_adaptation_.pool_stepsize(this->nom_epsilon_);
+            double epsilon = this->nom_epsilon_;
+            this->init_stepsize(info_writer);
+
+            // Center the next window on the pooled step size
+            if (!pooled)
+              epsilon = this->nom_epsilon_;
+            this->stepsize_adaptation_.set_mu(log(10 * epsilon));
+            this->stepsize_adaptation_.restart();
+          }
+        }
+        return s;
+      }
+
+      void disengage_adaptation() {
+        base_adapter::disengage_adaptation();
+        this->stepsize_adaptation_.complete_adaptation(this->nom_epsilon_);
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
@@ -0,0 +1,70 @@
+#ifndef STAN_MCMC_HMC_XHMC_ADAPT_LOWRANK_DIAG_E_XHMC_HPP
+#define STAN_MCMC_HMC_XHMC_ADAPT_LOWRANK_DIAG_E_XHMC_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/mcmc/stepsize_lowrank_var_adapter.hpp>
+#include <stan/mcmc/hmc/xhmc/lowrank_diag_e_xhmc.hpp>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Exhausive Hamiltonian Monte Carlo (XHMC) with multinomial sampling
+     * with a Gaussian-Euclidean disintegration and adaptive
+     * low-rank plus diagonal metric and adaptive step size
+     */
+    template <class Model, class BaseRNG>
+    class adapt_lowrank_diag_e_xhmc
+      : public lowrank_diag_e_xhmc<Model, BaseRNG>,
+        public stepsize_lowrank_var_adapter {
+    public:
+      adapt_lowrank_diag_e_xhmc(const Model& model, BaseRNG& rng)
+        : lowrank_diag_e_xhmc<Model, BaseRNG>(model, rng),
+          stepsize_lowrank_var_adapter(model.num_params_r()) {}
+
+      ~adapt_lowrank_diag_e_xhmc() {}
+
+      sample
+      transition(sample& init_sample,
+                 interface_callbacks::writer::base_writer& info_writer,
+                 interface_callbacks::writer::base_writer& error_writer) {
+        sample s
+          = lowrank_diag_e_xhmc<Model, BaseRNG>::transition(init_sample,
+                                                            info_writer,
+                                                            error_writer);
+
+        if (this->adapt_flag_) {
+          this->stepsize_adaptation_.learn_stepsize(this->nom_epsilon_,
+                                                    s.accept_stat());
+
+          bool update
+            = this->lowrank_var_adaptation_.learn_lowrank(this->z_.mInv,
+                                                          this->z_.mInv_U,
+                                                          this->z_.mInv_lambda,
+                                                          this->z_.q);
+
+          if (update) {
+            this->z_.update_mInv_factor();
+            bool pooled
+              = this->stepsize_adaptation_.pool_stepsize(this->nom_epsilon_);
+            double epsilon = this->nom_epsilon_;
+            this->init_stepsize(info_writer);
+
+            // Center the next window on the pooled step size
+            if (!pooled)
+              epsilon = this->nom_epsilon_;
+            this->stepsize_adaptation_.set_mu(log(10 * epsilon));
+            this->stepsize_adaptation_.restart();
+          }
+        }
+        return s;
+      }
+
+      void disengage_adaptation() {
+        base_adapter::disengage_adaptation();
+        this->stepsize_adaptation_.complete_adaptation(this->nom_epsilon_);
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
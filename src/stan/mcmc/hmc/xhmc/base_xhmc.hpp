@@ -90,10 +90,11 @@ namespace stan {
                  interface_callbacks::writer::base_writer& error_writer) {
         // Initialize the algorithm
         this->sample_stepsize();
+        this->integrator_.reset_statistics();
 
         this->seed(init_sample.cont_params());
 
-        this->hamiltonian_.sample_p(this->z_, this->rand_int_);
+        this->sample_momentum_();
         this->hamiltonian_.init(this->z_, info_writer, error_writer);
 
         ps_point z_plus(this->z_);
@@ -106,7 +107,7 @@ namespace stan {
                                               info_writer, error_writer);
         double log_sum_weight = 0;  // log(exp(H0 - H0))
 
-        double H0 = this->hamiltonian_.H(this->z_);
+        double H0 = this->hamiltonian_.H_cached(this->z_);
         int n_leapfrog = 0;
         double sum_metro_prob = 1;  // exp(H0 - H0)
 
@@ -165,7 +166,7 @@ namespace stan {
           = sum_metro_prob / static_cast<double>(n_leapfrog + 1);
 
         this->z_.ps_point::operator=(z_sample);
-        this->energy_ = this->hamiltonian_.H(this->z_);
+        this->energy_ = this->hamiltonian_.H_cached(this->z_);
         return sample(this->z_.q, -this->z_.V, accept_prob);
       }
 
@@ -175,6 +176,7 @@ namespace stan {
         names.push_back("n_leapfrog__");
         names.push_back("divergent__");
         names.push_back("energy__");
+        this->integrator_.get_param_names(names);
       }
 
       void get_sampler_params(std::vector<double>& values) {
@@ -183,6 +185,7 @@ namespace stan {
         values.push_back(this->n_leapfrog_);
         values.push_back(this->divergent_);
         values.push_back(this->energy_);
+        this->integrator_.get_params(values);
       }
 
       /**
@@ -214,7 +217,7 @@ namespace stan {
                                    info_writer, error_writer);
           ++n_leapfrog;
 
-          double h = this->hamiltonian_.H(this->z_);
+          double h = this->hamiltonian_.H_cached(this->z_);
           if (boost::math::isnan(h))
             h = std::numeric_limits<double>::infinity();
 
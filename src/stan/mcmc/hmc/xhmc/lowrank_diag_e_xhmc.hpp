@@ -0,0 +1,28 @@
+#ifndef STAN_MCMC_HMC_XHMC_LOWRANK_DIAG_E_XHMC_HPP
+#define STAN_MCMC_HMC_XHMC_LOWRANK_DIAG_E_XHMC_HPP
+
+#include <stan/mcmc/hmc/xhmc/base_xhmc.hpp>
+#include <stan/mcmc/hmc/hamiltonians/lowrank_diag_e_point.hpp>
+#include <stan/mcmc/hmc/hamiltonians/lowrank_diag_e_metric.hpp>
+#include <stan/mcmc/hmc/integrators/expl_leapfrog.hpp>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Exhausive Hamiltonian Monte Carlo (XHMC) with multinomial sampling
+     * with a Gaussian-Euclidean disintegration and low-rank
+     * plus diagonal metric
+     */
+    template <class Model, class BaseRNG>
+    class lowrank_diag_e_xhmc
+      : public base_xhmc<Model, lowrank_diag_e_metric,
+                         expl_leapfrog, BaseRNG> {
+    public:
+      lowrank_diag_e_xhmc(const Model& model, BaseRNG& rng)
+        : base_xhmc<Model, lowrank_diag_e_metric, expl_leapfrog,
+                    BaseRNG>(model, rng) { }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
@@ -0,0 +1,247 @@
+#ifndef STAN_MCMC_LOWRANK_VAR_ADAPTATION_HPP
+#define STAN_MCMC_LOWRANK_VAR_ADAPTATION_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/mcmc/chain_state.hpp>
+#include <stan/mcmc/windowed_adaptation.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <Eigen/Eigenvalues>
+#include <Eigen/QR>
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <ostream>
+
+namespace stan {
+
+  namespace mcmc {
+
+    /**
+     * Adapts a low-rank plus diagonal inverse metric
+     * S (I + U diag(lambda) U^T) S from the draws of each window.
+     *
+     * S is the regularized marginal standard deviation, as in
+     * var_adaptation, and U holds the leading principal directions
+     * of the draws scaled by their standard deviations.  No draw is
+     * kept: each one updates the Welford mean and variance and a
+     * sketch Y = M Omega of the sum of squares M against a fixed
+     * Gaussian test matrix Omega with 3 (rank + 10) columns, O(D k)
+     * per draw.  At the end of the window the directions come from
+     * a two-sided low-rank approximation of the scaled sketch
+     * (Tropp et al., 2017), which is exact when the scaled
+     * covariance is the identity plus a term of rank at most
+     * rank + 10.
+     */
+    class lowrank_var_adaptation: public windowed_adaptation {
+    public:
+      explicit lowrank_var_adaptation(int n)
+        : windowed_adaptation("low-rank variance"),
+          rank_(std::min(n, 10)), num_samples_(0),
+          mean_(Eigen::VectorXd::Zero(n)), m2_(Eigen::VectorXd::Zero(n)) {}
+
+      int rank() {
+        return rank_;
+      }
+
+      /**
+       * Sets the rank, which takes effect for the test matrix at the
+       * start of the next window.
+       */
+      void set_rank(int k) {
+        if (k >= 0) rank_ = k;
+      }
+
+      bool learn_lowrank(Eigen::VectorXd& var,
+                         Eigen::MatrixXd& U,
+                         Eigen::VectorXd& lambda,
+                         const Eigen::VectorXd& q) {
+        if (adaptation_window())
+          add_sample_(q);
+
+        if (end_adaptation_window()) {
+          compute_next_window();
+
+          Eigen::VectorXd previous = metric_diagonal_(var, U, lambda);
+          compute_metric_(var, U, lambda);
+          num_samples_ = 0;
+
+          // The change is measured on the diagonal of the inverse
+          // metric to stay O(D k)
+          record_window_change_(
+            (metric_diagonal_(var, U, lambda) - previous).norm(),
+            previous.norm());
+
+          ++adapt_window_counter_;
+          return true;
+        }
+
+        ++adapt_window_counter_;
+        return false;
+      }
+
+      /**
+       * Saves the window counters and the sketch of the current
+       * window, O(D k) whatever the number of draws.
+       */
+      void write_state(std::ostream& o) {
+        windowed_adaptation::write_state(o);
+        write_chain_state(o, num_samples_);
+        write_chain_state(o, mean_);
+        write_chain_state(o, m2_);
+        write_chain_state(o, omega_);
+        write_chain_state(o, sketch_);
+      }
+
+      void read_state(std::istream& in) {
+        windowed_adaptation::read_state(in);
+        read_chain_state_value(in, num_samples_);
+        read_chain_state(in, mean_);
+        read_chain_state(in, m2_);
+        read_chain_state(in, omega_);
+        read_chain_state(in, sketch_);
+      }
+
+    protected:
+      int rank_;
+
+      int num_samples_;
+      Eigen::VectorXd mean_;
+      Eigen::VectorXd m2_;
+      Eigen::MatrixXd omega_;
+      Eigen::MatrixXd sketch_;
+
+      void add_sample_(const Eigen::VectorXd& q) {
+        const int D = q.size();
+        if (num_samples_ == 0) {
+          mean_.setZero(D);
+          m2_.setZero(D);
+          // Range and co-range test matrices side by side
+          int l = std::min(D, rank_ + 10);
+          if (omega_.rows() != D || omega_.cols() != 3 * l)
+            omega_ = test_matrix_(D, 3 * l);
+          sketch_.setZero(D, 3 * l);
+        }
+
+        ++num_samples_;
+        Eigen::VectorXd delta = q - mean_;
+        mean_ += delta / num_samples_;
+        Eigen::VectorXd delta_new = q - mean_;
+        m2_ += delta.cwiseProduct(delta_new);
+
+        // M gains delta delta_new^T, as in the Welford update of m2
+        sketch_.noalias() += delta * (delta_new.transpose() * omega_);
+      }
+
+      void compute_metric_(Eigen::VectorXd& var,
+                           Eigen::MatrixXd& U,
+                           Eigen::VectorXd& lambda) {
+        const int D = var.size();
+        const int n = num_samples_;
+
+        var.setZero();
+        if (n > 1)
+          var = m2_ / (n - 1.0);
+
+        int k = std::min(rank_, std::min(D, n - 1));
+        if (k > 0 && var.maxCoeff() > 0) {
+          Eigen::VectorXd sd = var.cwiseSqrt();
+          Eigen::VectorXd scale(D);
+          for (int d = 0; d < D; ++d)
+            scale(d) = var(d) > 0 ? 1.0 / sd(d) : 0;
+
+          // For the scaled covariance R = S^-1 M S^-1 / (n - 1),
+          // R (S Omega) = S^-1 Y / (n - 1).  The metric is the
+          // identity plus a low-rank term, so the sketches are of
+          // R - I, whose tail is small, on the directions with
+          // nonzero variance
+          const int l = omega_.cols() / 3;
+          Eigen::MatrixXd omega = sd.asDiagonal() * omega_;
+          Eigen::MatrixXd Y = scale.asDiagonal() * sketch_ / (n - 1.0)
+                              - omega;
+
+          Eigen::VectorXd sigma;
+          two_sided_(omega.leftCols(l), Y.leftCols(l),
+                     omega.rightCols(omega.cols() - l),
+                     Y.rightCols(omega.cols() - l), k, U, sigma);
+          sigma.array() += 1.0;
+
+          // Shrink the correlations towards the diagonal metric
+          lambda = (n / (n + 5.0)) * (sigma.array() - 1.0).matrix();
+        } else {
+          U.resize(D, 0);
+          lambda.resize(0);
+        }
+
+        var = (n / (n + 5.0)) * var
+              + 1e-3 * (5.0 / (n + 5.0)) * Eigen::VectorXd::Ones(D);
+      }
+
+      static Eigen::VectorXd metric_diagonal_(const Eigen::VectorXd& var,
+                                              const Eigen::MatrixXd& U,
+                                              const Eigen::VectorXd& lambda) {
+        Eigen::VectorXd diag = Eigen::VectorXd::Ones(var.size());
+        if (U.rows() == var.size() && U.cols() == lambda.size())
+          diag += U.cwiseAbs2() * lambda;
+        return var.cwiseProduct(diag);
+      }
+
+      /**
+       * Gaussian test matrix from a fixed seed, so the sketch is a
+       * deterministic function of the draws.
+       */
+      static Eigen::MatrixXd test_matrix_(int D, int l) {
+        boost::ecuyer1988 rng(0);
+        boost::variate_generator<boost::ecuyer1988&,
+                                 boost::normal_distribution<> >
+          rand_unit_gaus(rng, boost::normal_distribution<>());
+
+        Eigen::MatrixXd omega(D, l);
+        for (int j = 0; j < l; ++j)
+          for (int d = 0; d < D; ++d)
+            omega(d, j) = rand_unit_gaus();
+        return omega;
+      }
+
+      /**
+       * Leading eigenpairs, at most k, of the symmetric A from the
+       * sketches Y = A Omega and W = A Psi, as Q (Q^T A Q) Q^T with
+       * Q an orthonormal basis of Y and Q^T A recovered from W by
+       * least squares (Tropp et al., 2017).
+       */
+      static void two_sided_(const Eigen::MatrixXd& omega,
+                             const Eigen::MatrixXd& Y,
+                             const Eigen::MatrixXd& psi,
+                             const Eigen::MatrixXd& W, int k,
+                             Eigen::MatrixXd& U,
+                             Eigen::VectorXd& sigma) {
+        const int D = Y.rows();
+        const int l = Y.cols();
+
+        Eigen::HouseholderQR<Eigen::MatrixXd> Y_qr(Y);
+        Eigen::MatrixXd Q = Y_qr.householderQ()
+                            * Eigen::MatrixXd::Identity(D, l);
+
+        Eigen::MatrixXd X = (psi.transpose() * Q)
+                            .colPivHouseholderQr()
+                            .solve(W.transpose());
+        Eigen::MatrixXd C = X * Q;
+        C = 0.5 * (C + C.transpose());
+
+        // Ritz pairs by decreasing eigenvalue
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> C_deco(C);
+        k = std::min(k, l);
+        U.resize(D, k);
+        sigma.resize(k);
+        for (int j = 0; j < k; ++j) {
+          sigma(j) = C_deco.eigenvalues()(l - 1 - j);
+          U.col(j) = Q * C_deco.eigenvectors().col(l - 1 - j);
+        }
+      }
+    };
+
+  }  // mcmc
+
+}  // stan
+#endif
@@ -2,7 +2,11 @@
 #define STAN_MCMC_STEPSIZE_ADAPTATION_HPP
 
 #include <stan/mcmc/base_adaptation.hpp>
+#include <stan/mcmc/chain_state.hpp>
 #include <cmath>
+#include <istream>
+#include <ostream>
+#include <vector>
 
 namespace stan {
 
@@ -12,7 +16,7 @@ namespace stan {
     public:
       stepsize_adaptation()
         : mu_(0.5), delta_(0.5), gamma_(0.05),
-          kappa_(0.75), t0_(10) {
+          kappa_(0.75), t0_(10), restart_pending_(false) {
         restart();
       }
 
@@ -59,13 +63,30 @@ namespace stan {
         return t0_;
       }
 
+      /**
+       * Averaged log step size, which complete_adaptation()
+       * would set for a single chain.
+       */
+      double get_x_bar() {
+        return x_bar_;
+      }
+
+      /**
+       * Restarts dual averaging.  A pooled adaptation restarts at
+       * its next learn_stepsize(), so chains reaching a window
+       * boundary later still pool the statistics of this window.
+       */
       void restart() {
-        counter_ = 0;
-        s_bar_ = 0;
-        x_bar_ = 0;
+        if (!pooled_())
+          restart_now_();
+        else
+          restart_pending_ = true;
       }
 
       void learn_stepsize(double& epsilon, double adapt_stat) {
+        if (restart_pending_)
+          restart_now_();
+
         ++counter_;
 
         adapt_stat = adapt_stat > 1 ? 1 : adapt_stat;
@@ -83,8 +104,93 @@ namespace stan {
         epsilon = std::exp(x);
       }
 
+      /**
+       * Pools the dual averaging statistics with other chains.  At
+       * each metric window boundary, pool_stepsize(), and when
+       * adaptation completes each chain takes the step size given by
+       * the mean averaged log step size across the pool.
+       *
+       * @param pool Adaptations of all chains, including this one;
+       *   a pool of fewer than two chains restores single chain
+       *   adaptation
+       */
+      void set_pool(const std::vector<stepsize_adaptation*>& pool) {
+        pool_ = pool;
+      }
+
+      /**
+       * Sets the step size to the pooled one at a metric window
+       * boundary, before the window restarts.  Without a pool the
+       * step size is left unchanged.
+       *
+       * The sampler should search for the step size of the next
+       * window starting from the pooled one, and center the dual
+       * averaging of that window on the pooled step size.
+       *
+       * @return true if the step size was pooled
+       */
+      bool pool_stepsize(double& epsilon) {
+        if (!pooled_())
+          return false;
+
+        double x_bar = 0;
+        for (size_t c = 0; c < pool_.size(); ++c)
+          x_bar += pool_[c]->x_bar_;
+        epsilon = std::exp(x_bar / pool_.size());
+        return true;
+      }
+
+      /**
+       * Sets the step size to the averaged one.  Pooled chains take
+       * the mean averaged log step size over the chains that have
+       * not restarted since their last update, or this chain's own
+       * if every chain has restarted.
+       */
       void complete_adaptation(double& epsilon) {
-        epsilon = std::exp(x_bar_);
+        double x_bar = 0;
+        int num_chains = 0;
+        if (pooled_()) {
+          for (size_t c = 0; c < pool_.size(); ++c) {
+            if (!pool_[c]->restart_pending_) {
+              x_bar += pool_[c]->x_bar_;
+              ++num_chains;
+            }
+          }
+        }
+
+        if (num_chains > 0)
+          epsilon = std::exp(x_bar / num_chains);
+        else
+          epsilon = std::exp(x_bar_);
+      }
+
+      /**
+       * Saves the dual averaging statistics and parameters, the
+       * state needed to continue adaptation exactly after
+       * read_state().
+       */
+      void write_state(std::ostream& o) {
+        write_chain_state(o, counter_);
+        write_chain_state(o, s_bar_);
+        write_chain_state(o, x_bar_);
+        write_chain_state(o, mu_);
+        write_chain_state(o, delta_);
+        write_chain_state(o, gamma_);
+        write_chain_state(o, kappa_);
+        write_chain_state(o, t0_);
+        write_chain_state(o, restart_pending_);
+      }
+
+      void read_state(std::istream& in) {
+        read_chain_state(in, counter_);
+        read_chain_state(in, s_bar_);
+        read_chain_state(in, x_bar_);
+        read_chain_state(in, mu_);
+        read_chain_state(in, delta_);
+        read_chain_state(in, gamma_);
+        read_chain_state(in, kappa_);
+        read_chain_state(in, t0_);
+        read_chain_state_value(in, restart_pending_);
       }
 
     protected:
@@ -96,6 +202,20 @@ namespace stan {
       double gamma_;    // Adaptation scaling
       double kappa_;    // Adaptation shrinkage
       double t0_;       // Effective starting iteration
+
+      std::vector<stepsize_adaptation*> pool_;
+      bool restart_pending_;
+
+      bool pooled_() const {
+        return pool_.size() > 1;
+      }
+
+      void restart_now_() {
+        counter_ = 0;
+        s_bar_ = 0;
+        x_bar_ = 0;
+        restart_pending_ = false;
+      }
     };
 
   }  // mcmc
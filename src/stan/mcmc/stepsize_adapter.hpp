@@ -16,6 +16,16 @@ namespace stan {
         return stepsize_adaptation_;
       }
 
+      void write_adaptation_state(std::ostream& o) {
+        base_adapter::write_adaptation_state(o);
+        stepsize_adaptation_.write_state(o);
+      }
+
+      void read_adaptation_state(std::istream& in) {
+        base_adapter::read_adaptation_state(in);
+        stepsize_adaptation_.read_state(in);
+      }
+
     protected:
       stepsize_adaptation stepsize_adaptation_;
     };
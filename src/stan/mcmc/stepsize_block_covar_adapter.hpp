@@ -0,0 +1,57 @@
+#ifndef STAN_MCMC_STEPSIZE_BLOCK_COVAR_ADAPTER_HPP
+#define STAN_MCMC_STEPSIZE_BLOCK_COVAR_ADAPTER_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/mcmc/base_adapter.hpp>
+#include <stan/mcmc/stepsize_adaptation.hpp>
+#include <stan/mcmc/block_covar_adaptation.hpp>
+
+namespace stan {
+  namespace mcmc {
+
+    class stepsize_block_covar_adapter: public base_adapter {
+    public:
+      explicit stepsize_block_covar_adapter(int n)
+        : block_covar_adaptation_(n) {
+      }
+
+      stepsize_adaptation& get_stepsize_adaptation() {
+        return stepsize_adaptation_;
+      }
+
+      block_covar_adaptation& get_block_covar_adaptation() {
+        return block_covar_adaptation_;
+      }
+
+      void set_window_params(unsigned int num_warmup,
+                             unsigned int init_buffer,
+                             unsigned int term_buffer,
+                             unsigned int base_window,
+                             interface_callbacks::writer::base_writer& writer) {
+        block_covar_adaptation_.set_window_params(num_warmup,
+                                                  init_buffer,
+                                                  term_buffer,
+                                                  base_window,
+                                                  writer);
+      }
+
+      void write_adaptation_state(std::ostream& o) {
+        base_adapter::write_adaptation_state(o);
+        stepsize_adaptation_.write_state(o);
+        block_covar_adaptation_.write_state(o);
+      }
+
+      void read_adaptation_state(std::istream& in) {
+        base_adapter::read_adaptation_state(in);
+        stepsize_adaptation_.read_state(in);
+        block_covar_adaptation_.read_state(in);
+      }
+
+    protected:
+      stepsize_adaptation stepsize_adaptation_;
+      block_covar_adaptation block_covar_adaptation_;
+    };
+
+  }  // mcmc
+}  // stan
+#endif
@@ -36,6 +36,18 @@ namespace stan {
                                             writer);
       }
 
+      void write_adaptation_state(std::ostream& o) {
+        base_adapter::write_adaptation_state(o);
+        stepsize_adaptation_.write_state(o);
+        covar_adaptation_.write_state(o);
+      }
+
+      void read_adaptation_state(std::istream& in) {
+        base_adapter::read_adaptation_state(in);
+        stepsize_adaptation_.read_state(in);
+        covar_adaptation_.read_state(in);
+      }
+
     protected:
       stepsize_adaptation stepsize_adaptation_;
       covar_adaptation covar_adaptation_;
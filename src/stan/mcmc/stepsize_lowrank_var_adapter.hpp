@@ -0,0 +1,57 @@
+#ifndef STAN_MCMC_STEPSIZE_LOWRANK_VAR_ADAPTER_HPP
+#define STAN_MCMC_STEPSIZE_LOWRANK_VAR_ADAPTER_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/mcmc/base_adapter.hpp>
+#include <stan/mcmc/stepsize_adaptation.hpp>
+#include <stan/mcmc/lowrank_var_adaptation.hpp>
+
+namespace stan {
+  namespace mcmc {
+
+    class stepsize_lowrank_var_adapter: public base_adapter {
+    public:
+      explicit stepsize_lowrank_var_adapter(int n)
+        : lowrank_var_adaptation_(n) {
+      }
+
+      stepsize_adaptation& get_stepsize_adaptation() {
+        return stepsize_adaptation_;
+      }
+
+      lowrank_var_adaptation& get_lowrank_var_adaptation() {
+        return lowrank_var_adaptation_;
+      }
+
+      void set_window_params(unsigned int num_warmup,
+                             unsigned int init_buffer,
+                             unsigned int term_buffer,
+                             unsigned int base_window,
+                             interface_callbacks::writer::base_writer& writer) {
+        lowrank_var_adaptation_.set_window_params(num_warmup,
+                                                  init_buffer,
+                                                  term_buffer,
+                                                  base_window,
+                                                  writer);
+      }
+
+      void write_adaptation_state(std::ostream& o) {
+        base_adapter::write_adaptation_state(o);
+        stepsize_adaptation_.write_state(o);
+        lowrank_var_adaptation_.write_state(o);
+      }
+
+      void read_adaptation_state(std::istream& in) {
+        base_adapter::read_adaptation_state(in);
+        stepsize_adaptation_.read_state(in);
+        lowrank_var_adaptation_.read_state(in);
+      }
+
+    protected:
+      stepsize_adaptation stepsize_adaptation_;
+      lowrank_var_adaptation lowrank_var_adaptation_;
+    };
+
+  }  // mcmc
+}  // stan
+#endif
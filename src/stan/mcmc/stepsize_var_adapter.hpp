@@ -35,6 +35,17 @@ namespace stan {
                                           writer);
       }
 
+      void write_adaptation_state(std::ostream& o) {
+        base_adapter::write_adaptation_state(o);
+        stepsize_adaptation_.write_state(o);
+        var_adaptation_.write_state(o);
+      }
+
+      void read_adaptation_state(std::istream& in) {
+        base_adapter::read_adaptation_state(in);
+        stepsize_adaptation_.read_state(in);
+        var_adaptation_.read_state(in);
+      }
 
     protected:
       stepsize_adaptation stepsize_adaptation_;
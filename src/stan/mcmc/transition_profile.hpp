@@ -0,0 +1,187 @@
+#ifndef STAN_MCMC_TRANSITION_PROFILE_HPP
+#define STAN_MCMC_TRANSITION_PROFILE_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Accumulates the CPU time and number of calls of the phases of
+     * MCMC transitions, both per iteration and over a run.
+     *
+     * A sampler only pays for profiling while a profile is
+     * attached.  Phases are timed with clock(), so phases shorter
+     * than its resolution are undercounted in time but not in
+     * calls.  Nested phases are timed independently: the integrator
+     * phase includes the gradient and kinetic phases it calls, and
+     * the transition phase includes all but the output phase.  The
+     * output phase includes the write_array phase, which computes
+     * the constrained values and generated quantities of a draw, so
+     * the remainder is the time spent formatting and writing.
+     */
+    class transition_profile {
+    public:
+      enum phase {
+        transition_phase,
+        integrator_phase,
+        gradient_phase,
+        kinetic_phase,
+        rng_phase,
+        output_phase,
+        write_array_phase,
+        num_phases
+      };
+
+      transition_profile()
+        : trace_writer_(0), num_iterations_(0),
+          start_(num_phases, 0),
+          iteration_time_(num_phases, 0), iteration_calls_(num_phases, 0),
+          total_time_(num_phases, 0), total_calls_(num_phases, 0) {}
+
+      static std::string phase_name(phase p) {
+        switch (p) {
+        case transition_phase:
+          return "transition";
+        case integrator_phase:
+          return "integrator";
+        case gradient_phase:
+          return "gradient";
+        case kinetic_phase:
+          return "kinetic";
+        case rng_phase:
+          return "rng";
+        case output_phase:
+          return "output";
+        case write_array_phase:
+          return "write_array";
+        default:
+          return "";
+        }
+      }
+
+      /**
+       * Sets a writer that receives one line per iteration with the
+       * calls and seconds of each phase, or 0 for no trace.
+       */
+      void set_trace_writer(interface_callbacks::writer::base_writer* writer) {
+        trace_writer_ = writer;
+        if (trace_writer_)
+          write_trace_header_();
+      }
+
+      void begin(phase p) {
+        start_[p] = clock();
+      }
+
+      void end(phase p) {
+        iteration_time_[p]
+          += static_cast<double>(clock() - start_[p]) / CLOCKS_PER_SEC;
+        ++iteration_calls_[p];
+      }
+
+      /**
+       * Adds the current iteration to the totals and writes it to
+       * the trace writer, if any.
+       */
+      void end_iteration() {
+        for (int p = 0; p < num_phases; ++p) {
+          total_time_[p] += iteration_time_[p];
+          total_calls_[p] += iteration_calls_[p];
+        }
+
+        if (trace_writer_) {
+          std::vector<double> values;
+          values.push_back(num_iterations_);
+          for (int p = 0; p < num_phases; ++p) {
+            values.push_back(iteration_calls_[p]);
+            values.push_back(iteration_time_[p]);
+          }
+          (*trace_writer_)(values);
+        }
+
+        iteration_time_.assign(num_phases, 0);
+        iteration_calls_.assign(num_phases, 0);
+        ++num_iterations_;
+      }
+
+      long num_iterations() const {
+        return num_iterations_;
+      }
+
+      double total_time(phase p) const {
+        return total_time_[p];
+      }
+
+      long total_calls(phase p) const {
+        return total_calls_[p];
+      }
+
+      void reset() {
+        num_iterations_ = 0;
+        iteration_time_.assign(num_phases, 0);
+        iteration_calls_.assign(num_phases, 0);
+        total_time_.assign(num_phases, 0);
+        total_calls_.assign(num_phases, 0);
+      }
+
+      /**
+       * Writes the calls and seconds of each phase over all
+       * completed iterations, and the share of transition time
+       * spent in model gradients.
+       */
+      void write_summary(interface_callbacks::writer::base_writer& writer) {
+        std::stringstream ss;
+        writer();
+        ss << "Profile of " << num_iterations_ << " iterations:";
+        writer(ss.str());
+
+        for (int p = 0; p < num_phases; ++p) {
+          ss.str("");
+          ss << "  " << std::setw(12) << std::left
+             << phase_name(static_cast<phase>(p))
+             << std::setw(12) << std::right << total_calls_[p] << " calls "
+             << std::setw(12) << total_time_[p] << " seconds";
+          writer(ss.str());
+        }
+
+        if (total_time_[transition_phase] > 0) {
+          ss.str("");
+          ss << "  Gradient share of transition time: "
+             << 100.0 * total_time_[gradient_phase]
+                / total_time_[transition_phase] << "%";
+          writer(ss.str());
+        }
+        writer();
+      }
+
+    private:
+      interface_callbacks::writer::base_writer* trace_writer_;
+      long num_iterations_;
+
+      std::vector<clock_t> start_;
+      std::vector<double> iteration_time_;
+      std::vector<long> iteration_calls_;
+      std::vector<double> total_time_;
+      std::vector<long> total_calls_;
+
+      void write_trace_header_() {
+        std::vector<std::string> names;
+        names.push_back("iteration");
+        for (int p = 0; p < num_phases; ++p) {
+          std::string name = phase_name(static_cast<phase>(p));
+          names.push_back(name + "_calls");
+          names.push_back(name + "_seconds");
+        }
+        (*trace_writer_)(names);
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
@@ -2,8 +2,10 @@
 #define STAN_MCMC_VAR_ADAPTATION_HPP
 
 #include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/mcmc/chain_state.hpp>
 #include <stan/mcmc/windowed_adaptation.hpp>
-#include <stan/math/prim/mat/fun/welford_var_estimator.hpp>
+#include <istream>
+#include <ostream>
 #include <vector>
 
 namespace stan {
@@ -13,22 +15,60 @@ namespace stan {
     class var_adaptation: public windowed_adaptation {
     public:
       explicit var_adaptation(int n)
-        : windowed_adaptation("variance"), estimator_(n) {}
+        : windowed_adaptation("variance"), estimator_(n),
+          restart_pending_(false) {}
+
+      /**
+       * Pools the variance estimate with other chains that advance
+       * in lockstep with this one and share its window parameters.
+       * At every window boundary each chain combines the Welford
+       * statistics of all chains in the pool, so every chain ends
+       * the window with the same variance.
+       *
+       * To keep the pooled estimate identical across chains, the
+       * draw at the window boundary itself is not added and each
+       * estimator is only restarted at the first draw of the next
+       * window, after every chain has read it.
+       *
+       * @param pool Adaptations of all chains, including this one;
+       *   a pool of fewer than two chains restores single chain
+       *   adaptation
+       */
+      void set_pool(const std::vector<var_adaptation*>& pool) {
+        pool_ = pool;
+      }
 
       bool learn_variance(Eigen::VectorXd& var, const Eigen::VectorXd& q) {
-        if (adaptation_window())
+        if (restart_pending_) {
+          estimator_.restart();
+          restart_pending_ = false;
+        }
+
+        bool pooled = pool_.size() > 1;
+
+        if (adaptation_window() && !(pooled && end_adaptation_window()))
           estimator_.add_sample(q);
 
         if (end_adaptation_window()) {
           compute_next_window();
+          Eigen::VectorXd previous = var;
 
-          estimator_.sample_variance(var);
+          double n = 0;
+          if (pooled) {
+            n = pooled_variance(var);
+          } else {
+            estimator_.sample_variance(var);
+            n = static_cast<double>(estimator_.num_samples());
+          }
 
-          double n = static_cast<double>(estimator_.num_samples());
           var = (n / (n + 5.0)) * var
                 + 1e-3 * (5.0 / (n + 5.0)) * Eigen::VectorXd::Ones(var.size());
+          record_window_change_((var - previous).norm(), previous.norm());
 
-          estimator_.restart();
+          if (pooled)
+            restart_pending_ = true;
+          else
+            estimator_.restart();
 
           ++adapt_window_counter_;
           return true;
@@ -38,8 +78,61 @@ namespace stan {
         return false;
       }
 
+      void write_state(std::ostream& o) {
+        windowed_adaptation::write_state(o);
+        estimator_.write_state(o);
+        write_chain_state(o, restart_pending_);
+      }
+
+      void read_state(std::istream& in) {
+        windowed_adaptation::read_state(in);
+        estimator_.read_state(in);
+        read_chain_state_value(in, restart_pending_);
+      }
+
     protected:
-      stan::math::welford_var_estimator estimator_;
+      restorable_var_estimator estimator_;
+      std::vector<var_adaptation*> pool_;
+      bool restart_pending_;
+
+      /**
+       * Combines the Welford statistics of every chain in the pool.
+       *
+       * @param[out] var Pooled sample variance
+       * @return Pooled number of samples
+       */
+      double pooled_variance(Eigen::VectorXd& var) {
+        double n = 0;
+        Eigen::VectorXd mean = Eigen::VectorXd::Zero(var.size());
+        Eigen::VectorXd chain_mean(var.size());
+
+        for (size_t c = 0; c < pool_.size(); ++c) {
+          double n_c = pool_[c]->estimator_.num_samples();
+          if (n_c == 0) continue;
+          pool_[c]->estimator_.sample_mean(chain_mean);
+          n += n_c;
+          mean += (n_c / n) * (chain_mean - mean);
+        }
+
+        if (n < 2) return n;
+
+        Eigen::VectorXd m2 = Eigen::VectorXd::Zero(var.size());
+        Eigen::VectorXd chain_var(var.size());
+
+        for (size_t c = 0; c < pool_.size(); ++c) {
+          double n_c = pool_[c]->estimator_.num_samples();
+          if (n_c == 0) continue;
+          pool_[c]->estimator_.sample_mean(chain_mean);
+          if (n_c > 1) {
+            pool_[c]->estimator_.sample_variance(chain_var);
+            m2 += (n_c - 1) * chain_var;
+          }
+          m2 += n_c * (chain_mean - mean).cwiseAbs2();
+        }
+
+        var = m2 / (n - 1.0);
+        return n;
+      }
     };
 
   }  // mcmc
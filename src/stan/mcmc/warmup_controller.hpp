@@ -0,0 +1,140 @@
+#ifndef STAN_MCMC_WARMUP_CONTROLLER_HPP
+#define STAN_MCMC_WARMUP_CONTROLLER_HPP
+
+#include <stan/mcmc/chain_state.hpp>
+#include <stan/mcmc/stepsize_adaptation.hpp>
+#include <stan/mcmc/windowed_adaptation.hpp>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <istream>
+#include <ostream>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Ends warmup once adaptation has stabilized.
+     *
+     * Warmup can end when the averaged step size of the dual
+     * averaging has moved by less than the step size tolerance over
+     * the last stepsize_window iterations, and the metric estimate
+     * changed by less than the metric tolerance between the last two
+     * adaptation windows, or no window is scheduled.  The step size
+     * history restarts whenever a window ends, as the step size
+     * adaptation restarts with the new metric.  Warmup always runs
+     * for at least min_warmup and at most max_warmup iterations.
+     */
+    class warmup_controller {
+    public:
+      /**
+       * @param stepsize Step size adaptation of the sampler
+       * @param metric Metric adaptation of the sampler, or 0 for
+       *   samplers that only adapt the step size
+       * @param min_warmup Minimum number of warmup iterations
+       * @param max_warmup Maximum number of warmup iterations
+       */
+      warmup_controller(stepsize_adaptation& stepsize,
+                        windowed_adaptation* metric,
+                        unsigned int min_warmup,
+                        unsigned int max_warmup)
+        : stepsize_(stepsize), metric_(metric),
+          min_warmup_(min_warmup), max_warmup_(max_warmup),
+          stepsize_window_(50), stepsize_tol_(0.05), metric_tol_(0.1),
+          iteration_(0), num_windows_(0) {}
+
+      void set_min_warmup(unsigned int n) {
+        min_warmup_ = n;
+      }
+
+      void set_stepsize_window(unsigned int n) {
+        if (n > 0) stepsize_window_ = n;
+      }
+
+      void set_stepsize_tolerance(double tol) {
+        if (tol > 0) stepsize_tol_ = tol;
+      }
+
+      void set_metric_tolerance(double tol) {
+        if (tol > 0) metric_tol_ = tol;
+      }
+
+      unsigned int iteration() {
+        return iteration_;
+      }
+
+      /**
+       * Records a warmup iteration, to be called after each warmup
+       * transition.
+       *
+       * @return true if warmup should end
+       */
+      bool update() {
+        ++iteration_;
+
+        if (metric_ && metric_->num_windows() != num_windows_) {
+          num_windows_ = metric_->num_windows();
+          log_stepsizes_.clear();
+        }
+
+        log_stepsizes_.push_back(stepsize_.get_x_bar());
+        if (log_stepsizes_.size() > stepsize_window_)
+          log_stepsizes_.pop_front();
+
+        if (iteration_ >= max_warmup_)
+          return true;
+        if (iteration_ < min_warmup_)
+          return false;
+
+        return stepsize_stable() && metric_stable();
+      }
+
+      bool stepsize_stable() {
+        if (log_stepsizes_.size() < stepsize_window_)
+          return false;
+        double spread
+          = *std::max_element(log_stepsizes_.begin(), log_stepsizes_.end())
+          - *std::min_element(log_stepsizes_.begin(), log_stepsizes_.end());
+        return spread <= std::log(1 + stepsize_tol_);
+      }
+
+      /**
+       * The metric is stable if it is not adapted, or no window is
+       * scheduled so it never changes, or it changed by less than
+       * the tolerance between the last two windows.
+       */
+      bool metric_stable() {
+        return !metric_ || !metric_->windows_scheduled()
+               || metric_->window_change() <= metric_tol_;
+      }
+
+      void write_state(std::ostream& o) {
+        write_chain_state(o, iteration_);
+        write_chain_state(o, num_windows_);
+        write_chain_state(o, log_stepsizes_);
+      }
+
+      void read_state(std::istream& in) {
+        read_chain_state_value(in, iteration_);
+        read_chain_state_value(in, num_windows_);
+        read_chain_state(in, log_stepsizes_);
+      }
+
+    private:
+      stepsize_adaptation& stepsize_;
+      windowed_adaptation* metric_;
+
+      unsigned int min_warmup_;
+      unsigned int max_warmup_;
+      unsigned int stepsize_window_;
+      double stepsize_tol_;
+      double metric_tol_;
+
+      unsigned int iteration_;
+      unsigned int num_windows_;
+      std::deque<double> log_stepsizes_;
+    };
+
+  }  // mcmc
+}  // stan
+#endif
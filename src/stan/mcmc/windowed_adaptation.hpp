@@ -3,6 +3,9 @@
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
 #include <stan/mcmc/base_adaptation.hpp>
+#include <stan/mcmc/chain_state.hpp>
+#include <istream>
+#include <limits>
 #include <ostream>
 #include <string>
 
@@ -25,6 +28,9 @@ namespace stan {
         adapt_window_counter_ = 0;
         adapt_window_size_ = adapt_base_window_;
         adapt_next_window_ = adapt_init_buffer_ + adapt_window_size_ - 1;
+
+        num_windows_ = 0;
+        window_change_ = std::numeric_limits<double>::infinity();
       }
 
       void set_window_params(unsigned int num_warmup,
@@ -47,10 +53,15 @@ namespace stan {
           num_warmup_ = num_warmup;
           adapt_init_buffer_ = 0.15 * num_warmup;
           adapt_term_buffer_ = 0.10 * num_warmup;
-          adapt_base_window_
-            = num_warmup - (adapt_init_buffer_ + adapt_term_buffer_);
-
-          writer("         Defaulting to a 15%/75%/10% partition,");
+          // A zero window stays zero, so the metric is still kept
+          if (base_window > 0) {
+            adapt_base_window_
+              = num_warmup - (adapt_init_buffer_ + adapt_term_buffer_);
+            writer("         Defaulting to a 15%/75%/10% partition,");
+          } else {
+            adapt_base_window_ = 0;
+            writer("         Defaulting to a 15%/10% buffer partition,");
+          }
 
           std::stringstream msg;
           msg << "           init_buffer = " << adapt_init_buffer_;
@@ -81,9 +92,12 @@ namespace stan {
                && (adapt_window_counter_ != num_warmup_);
       }
 
+      // A base window of zero turns off the estimation, so a
+      // metric loaded from an earlier run is kept during warmup
       bool end_adaptation_window() {
         return (adapt_window_counter_ == adapt_next_window_)
-               && (adapt_window_counter_ != num_warmup_);
+               && (adapt_window_counter_ != num_warmup_)
+               && (adapt_base_window_ > 0);
       }
 
       void compute_next_window() {
@@ -106,6 +120,60 @@ namespace stan {
         }
       }
 
+      /**
+       * Whether any adaptation window is scheduled, which is not the
+       * case for a zero base window or num_warmup < 20.
+       */
+      bool windows_scheduled() {
+        return num_warmup_ > 0 && adapt_base_window_ > 0;
+      }
+
+      /**
+       * Number of adaptation windows ended since the last restart.
+       */
+      unsigned int num_windows() {
+        return num_windows_;
+      }
+
+      /**
+       * Relative change of the estimate at the end of the last
+       * window; infinite until two windows have ended, as the first
+       * estimate replaces the initial metric.  The change is in the
+       * Frobenius norm of the inverse metric, except for the
+       * low-rank metric, which measures it on the diagonal.
+       */
+      double window_change() {
+        return window_change_;
+      }
+
+      /**
+       * Saves the window parameters and counters, the state needed
+       * to continue warmup exactly after read_state().
+       */
+      void write_state(std::ostream& o) {
+        write_chain_state(o, num_warmup_);
+        write_chain_state(o, adapt_init_buffer_);
+        write_chain_state(o, adapt_term_buffer_);
+        write_chain_state(o, adapt_base_window_);
+        write_chain_state(o, adapt_window_counter_);
+        write_chain_state(o, adapt_next_window_);
+        write_chain_state(o, adapt_window_size_);
+        write_chain_state(o, num_windows_);
+        write_chain_state(o, window_change_);
+      }
+
+      void read_state(std::istream& in) {
+        read_chain_state_value(in, num_warmup_);
+        read_chain_state_value(in, adapt_init_buffer_);
+        read_chain_state_value(in, adapt_term_buffer_);
+        read_chain_state_value(in, adapt_base_window_);
+        read_chain_state_value(in, adapt_window_counter_);
+        read_chain_state_value(in, adapt_next_window_);
+        read_chain_state_value(in, adapt_window_size_);
+        read_chain_state_value(in, num_windows_);
+        read_chain_state(in, window_change_);
+      }
+
     protected:
       std::string estimator_name_;
 
@@ -117,6 +185,17 @@ namespace stan {
       unsigned int adapt_window_counter_;
       unsigned int adapt_next_window_;
       unsigned int adapt_window_size_;
+
+      unsigned int num_windows_;
+      double window_change_;
+
+      void record_window_change_(double diff_norm, double previous_norm) {
+        if (num_windows_ > 0)
+          window_change_ = previous_norm > 0
+                           ? diff_norm / previous_norm
+                           : std::numeric_limits<double>::infinity();
+        ++num_windows_;
+      }
     };
 
   }  // mcmc
@@ -0,0 +1,24 @@
+#ifndef STAN_MODEL_COUNT_GRADIENT_HPP
+#define STAN_MODEL_COUNT_GRADIENT_HPP
+
+namespace stan {
+
+  namespace model {
+
+    /**
+     * Records one evaluation of the gradient of the log density of
+     * a model.  Called unqualified at every gradient entry point, so
+     * wrappers such as counting_model can overload it; for other
+     * models it does nothing.
+     *
+     * @tparam M Class of model.
+     * @param[in] model Model.
+     */
+    template <class M>
+    inline void count_gradient(const M& model) {}
+
+  }
+
+}
+
+#endif
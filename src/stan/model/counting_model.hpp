@@ -0,0 +1,213 @@
+#ifndef STAN_MODEL_COUNTING_MODEL_HPP
+#define STAN_MODEL_COUNTING_MODEL_HPP
+
+#include <stan/io/var_context.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/model/count_gradient.hpp>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+
+  namespace model {
+
+    /**
+     * Thrown by budget checks once a counting_model has evaluated
+     * as many gradients as its budget allows.
+     */
+    class gradient_budget_exhausted : public std::runtime_error {
+    public:
+      explicit gradient_budget_exhausted(long num_gradients)
+        : std::runtime_error(message_(num_gradients)),
+          num_gradients_(num_gradients) {}
+
+      long num_gradients() const {
+        return num_gradients_;
+      }
+
+    private:
+      long num_gradients_;
+
+      static std::string message_(long num_gradients) {
+        std::stringstream ss;
+        ss << "Gradient evaluation budget exhausted after "
+           << num_gradients << " gradient evaluations";
+        return ss.str();
+      }
+    };
+
+    /**
+     * Wraps a model, forwarding the model concept to it while
+     * counting evaluations of the log density and of its gradient,
+     * wherever they come from: initialization, step size search,
+     * transitions, line searches or ELBO estimates.
+     *
+     * Every call of log_prob counts as a log density evaluation,
+     * whatever its scalar type, so the log density evaluations
+     * include those of gradients.  Gradients are counted by the
+     * gradient entry points through count_gradient(), which the
+     * Riemannian metrics also call once per metric update, so
+     * autodiff sweeps for Hessians and their products are not
+     * counted as gradients.
+     *
+     * The wrapper never interrupts an evaluation, because the
+     * algorithms treat exceptions from the model as rejections.
+     * Services stop at a budget through budget checks between
+     * iterations; see
+     * stan::interface_callbacks::interrupt::gradient_budget.
+     *
+     * @tparam M Class of model.
+     */
+    template <class M>
+    class counting_model {
+    public:
+      /**
+       * @param model Model to wrap, which must outlive the wrapper.
+       * @param max_gradients Budget of gradient evaluations, or 0
+       *   for no budget.
+       */
+      explicit counting_model(const M& model, long max_gradients = 0)
+        : model_(model), max_gradients_(max_gradients),
+          num_log_probs_(0), num_gradients_(0) {}
+
+      const M& model() const {
+        return model_;
+      }
+
+      long num_log_probs() const {
+        return num_log_probs_;
+      }
+
+      long num_gradients() const {
+        return num_gradients_;
+      }
+
+      long max_gradients() const {
+        return max_gradients_;
+      }
+
+      bool budget_exhausted() const {
+        return max_gradients_ > 0 && num_gradients_ >= max_gradients_;
+      }
+
+      void count_gradient() const {
+        ++num_gradients_;
+      }
+
+      void reset_counts() {
+        num_log_probs_ = 0;
+        num_gradients_ = 0;
+      }
+
+      size_t num_params_r() const {
+        return model_.num_params_r();
+      }
+
+      size_t num_params_i() const {
+        return model_.num_params_i();
+      }
+
+      std::pair<int, int> param_range_i(size_t idx) const {
+        return model_.param_range_i(idx);
+      }
+
+      template <bool propto, bool jacobian, typename T>
+      T log_prob(std::vector<T>& params_r,
+                 std::vector<int>& params_i,
+                 std::ostream* msgs = 0) const {
+        ++num_log_probs_;
+        return model_.template log_prob<propto, jacobian, T>(params_r,
+                                                             params_i,
+                                                             msgs);
+      }
+
+      template <bool propto, bool jacobian, typename T>
+      T log_prob(Eigen::Matrix<T, Eigen::Dynamic, 1>& params_r,
+                 std::ostream* msgs = 0) const {
+        ++num_log_probs_;
+        return model_.template log_prob<propto, jacobian, T>(params_r, msgs);
+      }
+
+      void transform_inits(const stan::io::var_context& context,
+                           std::vector<int>& params_i,
+                           std::vector<double>& params_r,
+                           std::ostream* msgs) const {
+        model_.transform_inits(context, params_i, params_r, msgs);
+      }
+
+      void transform_inits(const stan::io::var_context& context,
+                           Eigen::Matrix<double, Eigen::Dynamic, 1>& params_r,
+                           std::ostream* msgs) const {
+        model_.transform_inits(context, params_r, msgs);
+      }
+
+      template <typename RNG>
+      void write_array(RNG& base_rng,
+                       std::vector<double>& params_r,
+                       std::vector<int>& params_i,
+                       std::vector<double>& vars,
+                       bool include_tparams = true,
+                       bool include_gqs = true,
+                       std::ostream* msgs = 0) const {
+        model_.write_array(base_rng, params_r, params_i, vars,
+                           include_tparams, include_gqs, msgs);
+      }
+
+      template <typename RNG>
+      void write_array(RNG& base_rng,
+                       Eigen::Matrix<double, Eigen::Dynamic, 1>& params_r,
+                       Eigen::Matrix<double, Eigen::Dynamic, 1>& vars,
+                       bool include_tparams = true,
+                       bool include_gqs = true,
+                       std::ostream* msgs = 0) const {
+        model_.write_array(base_rng, params_r, vars,
+                           include_tparams, include_gqs, msgs);
+      }
+
+      void get_dims(std::vector<std::vector<size_t> >& dimss) const {
+        model_.get_dims(dimss);
+      }
+
+      void get_param_names(std::vector<std::string>& names) const {
+        model_.get_param_names(names);
+      }
+
+      void constrained_param_names(std::vector<std::string>& param_names,
+                                   bool include_tparams = true,
+                                   bool include_gqs = true) const {
+        model_.constrained_param_names(param_names,
+                                       include_tparams, include_gqs);
+      }
+
+      void unconstrained_param_names(std::vector<std::string>& param_names,
+                                     bool include_tparams = true,
+                                     bool include_gqs = true) const {
+        model_.unconstrained_param_names(param_names,
+                                         include_tparams, include_gqs);
+      }
+
+      static std::string model_name() {
+        return M::model_name();
+      }
+
+    private:
+      const M& model_;
+      long max_gradients_;
+      mutable long num_log_probs_;
+      mutable long num_gradients_;
+    };
+
+    template <class M>
+    inline void count_gradient(const counting_model<M>& model) {
+      model.count_gradient();
+    }
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef STAN_MODEL_GRADIENT_ARENA_HPP
+#define STAN_MODEL_GRADIENT_ARENA_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/model/count_gradient.hpp>
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace stan {
+
+  namespace model {
+
+    /**
+     * Repeated gradient evaluations of a model on the autodiff
+     * stack, with high-water-mark statistics of the memory each
+     * gradient needs.
+     *
+     * Between gradients the stack is reset with recover_memory(),
+     * which keeps both the arena blocks and the capacity of the
+     * stack of vari pointers, so after the first few evaluations a
+     * gradient allocates no memory from the system.  The statistics
+     * are taken after the log density has been recorded and before
+     * the reverse pass, when the tape is at its largest.
+     */
+    class gradient_arena {
+    public:
+      gradient_arena()
+        : num_gradients_(0), max_var_stack_size_(0),
+          max_bytes_allocated_(0) {}
+
+      /**
+       * Compute the log density and its gradient, as
+       * stan::model::gradient does, recording the size of the tape.
+       *
+       * @tparam M Class of model.
+       * @param[in] model Model.
+       * @param[in] x Unconstrained parameters.
+       * @param[out] f Log density.
+       * @param[out] grad_f Gradient of the log density.
+       * @param[in,out] msgs
+       */
+      template <class M>
+      void gradient(const M& model,
+                    const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                    double& f,
+                    Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_f,
+                    std::ostream* msgs = 0) {
+        using stan::math::var;
+        count_gradient(model);
+        try {
+          Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x.size());
+          for (int i = 0; i < x.size(); ++i)
+            x_var(i) = x(i);
+          var f_var = model.template log_prob<true, true, var>(x_var, msgs);
+          record_tape_();
+          f = f_var.val();
+          grad_f.resize(x.size());
+          stan::math::grad(f_var.vi_);
+          for (int i = 0; i < x.size(); ++i)
+            grad_f(i) = x_var(i).adj();
+        } catch (const std::exception& e) {
+          stan::math::recover_memory();
+          throw;
+        }
+        stan::math::recover_memory();
+      }
+
+      template <class M>
+      void gradient(const M& model,
+                    const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                    double& f,
+                    Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_f,
+                    stan::interface_callbacks::writer::base_writer& writer) {
+        std::stringstream ss;
+        try {
+          gradient(model, x, f, grad_f, &ss);
+        } catch (std::exception& e) {
+          if (ss.str().length() > 0)
+            writer(ss.str());
+          throw;
+        }
+        if (ss.str().length() > 0)
+          writer(ss.str());
+      }
+
+      /**
+       * Number of gradients whose log density was recorded.
+       */
+      long num_gradients() const {
+        return num_gradients_;
+      }
+
+      /**
+       * Largest number of vari on the tape of any gradient.
+       */
+      size_t max_var_stack_size() const {
+        return max_var_stack_size_;
+      }
+
+      /**
+       * Largest number of bytes held by the autodiff arena at the
+       * end of any forward pass.  The arena only grows, so this is
+       * also its size after the most recent gradient.
+       */
+      size_t max_bytes_allocated() const {
+        return max_bytes_allocated_;
+      }
+
+      void reset_statistics() {
+        num_gradients_ = 0;
+        max_var_stack_size_ = 0;
+        max_bytes_allocated_ = 0;
+      }
+
+    private:
+      long num_gradients_;
+      size_t max_var_stack_size_;
+      size_t max_bytes_allocated_;
+
+      void record_tape_() {
+        ++num_gradients_;
+        size_t var_stack_size
+          = stan::math::ChainableStack::var_stack_.size()
+          + stan::math::ChainableStack::var_nochain_stack_.size();
+        if (var_stack_size > max_var_stack_size_)
+          max_var_stack_size_ = var_stack_size;
+        size_t bytes_allocated
+          = stan::math::ChainableStack::memalloc_.bytes_allocated();
+        if (bytes_allocated > max_bytes_allocated_)
+          max_bytes_allocated_ = bytes_allocated;
+      }
+    };
+
+  }
+
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include <stan/math/fwd/mat/functor/jacobian.hpp>
 #include <stan/math/rev/mat/functor/jacobian.hpp>
 #include <stan/math/mix/mat/functor/partial_derivative.hpp>
+#include <stan/model/count_gradient.hpp>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -96,6 +97,7 @@ namespace stan {
                          std::ostream* msgs = 0) {
       using std::vector;
       using stan::math::var;
+      count_gradient(model);
       double lp;
       try {
         vector<var> ad_params_r(params_r.size());
@@ -186,6 +188,7 @@ namespace stan {
                          std::ostream* msgs = 0) {
       using std::vector;
       using stan::math::var;
+      count_gradient(model);
 
       Eigen::Matrix<var, Eigen::Dynamic, 1> ad_params_r(params_r.size());
       for (size_t i = 0; i < model.num_params_r(); ++i) {
@@ -424,6 +427,7 @@ namespace stan {
                   double& f,
                   Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_f,
                   std::ostream* msgs = 0) {
+      count_gradient(model);
       stan::math::gradient(model_functional<M>(model, msgs), x, f, grad_f);
     }
 
@@ -433,6 +437,7 @@ namespace stan {
                   double& f,
                   Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_f,
                   stan::interface_callbacks::writer::base_writer& writer) {
+      count_gradient(model);
       std::stringstream ss;
       try {
         stan::math::gradient(model_functional<M>(model, &ss), x, f, grad_f);
@@ -445,6 +450,66 @@ namespace stan {
         writer(ss.str());
     }
 
+    /**
+     * Evaluate the log density and its gradient at each column of
+     * the specified matrix of unconstrained parameters.
+     *
+     * Points are evaluated in turn on the calling thread, and the
+     * memory of the autodiff stack is reused from one point to the
+     * next.  The evaluation is serial because the autodiff stack is
+     * process-wide, as described for services::mcmc::run_chains.
+     * If a point throws, the exception propagates and the remaining
+     * points are not evaluated.
+     *
+     * @tparam M Class of model.
+     * @param[in] model Model.
+     * @param[in] x Parameters, one point per column.
+     * @param[out] f Log density at each point.
+     * @param[out] grad_f Gradients, one point per column.
+     * @param[in,out] msgs
+     */
+    template <class M>
+    void gradients(const M& model,
+                   const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>&
+                   x,
+                   Eigen::Matrix<double, Eigen::Dynamic, 1>& f,
+                   Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>&
+                   grad_f,
+                   std::ostream* msgs = 0) {
+      f.resize(x.cols());
+      grad_f.resize(x.rows(), x.cols());
+
+      Eigen::Matrix<double, Eigen::Dynamic, 1> x_k(x.rows());
+      Eigen::Matrix<double, Eigen::Dynamic, 1> grad_f_k(x.rows());
+      for (int k = 0; k < x.cols(); ++k) {
+        x_k = x.col(k);
+        count_gradient(model);
+        stan::math::gradient(model_functional<M>(model, msgs),
+                             x_k, f(k), grad_f_k);
+        grad_f.col(k) = grad_f_k;
+      }
+    }
+
+    template <class M>
+    void gradients(const M& model,
+                   const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>&
+                   x,
+                   Eigen::Matrix<double, Eigen::Dynamic, 1>& f,
+                   Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>&
+                   grad_f,
+                   stan::interface_callbacks::writer::base_writer& writer) {
+      std::stringstream ss;
+      try {
+        gradients(model, x, f, grad_f, &ss);
+      } catch (std::exception& e) {
+        if (ss.str().length() > 0)
+          writer(ss.str());
+        throw;
+      }
+      if (ss.str().length() > 0)
+        writer(ss.str());
+    }
+
     template <class M>
     void hessian(const M& model,
                  const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
@@ -452,6 +517,7 @@ namespace stan {
                  Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_f,
                  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& hess_f,
                  std::ostream* msgs = 0) {
+      count_gradient(model);
       stan::math::hessian(model_functional<M>(model, msgs),
                           x, f, grad_f, hess_f);
     }
@@ -10,6 +10,9 @@
 #include <stan/services/arguments/arg_adapt_init_buffer.hpp>
 #include <stan/services/arguments/arg_adapt_term_buffer.hpp>
 #include <stan/services/arguments/arg_adapt_window.hpp>
+#include <stan/services/arguments/arg_adapt_early_stop.hpp>
+#include <stan/services/arguments/arg_adapt_min_warmup.hpp>
+#include <stan/services/arguments/arg_adapt_streaming.hpp>
 
 namespace stan {
   namespace services {
@@ -27,6 +30,9 @@ namespace stan {
         _subarguments.push_back(new arg_adapt_init_buffer());
         _subarguments.push_back(new arg_adapt_term_buffer());
         _subarguments.push_back(new arg_adapt_window());
+        _subarguments.push_back(new arg_adapt_early_stop());
+        _subarguments.push_back(new arg_adapt_min_warmup());
+        _subarguments.push_back(new arg_adapt_streaming());
       }
     };
 
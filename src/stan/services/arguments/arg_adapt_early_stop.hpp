@@ -0,0 +1,26 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_ADAPT_EARLY_STOP_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_ADAPT_EARLY_STOP_HPP
+
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_adapt_early_stop: public bool_argument {
+    public:
+      arg_adapt_early_stop(): bool_argument() {
+        _name = "early_stop";
+        _description = "End warmup once step size and metric are stable?";
+        _validity = "[0, 1]";
+        _default = "0";
+        _default_value = false;
+        _constrained = false;
+        _good_value = 1;
+        _value = _default_value;
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_ADAPT_MIN_WARMUP_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_ADAPT_MIN_WARMUP_HPP
+
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_adapt_min_warmup: public u_int_argument {
+    public:
+      arg_adapt_min_warmup(): u_int_argument() {
+        _name = "min_warmup";
+        _description = "Minimum number of warmup iterations "
+                       "with early_stop";
+        _default = "150";
+        _default_value = 150;
+        _value = _default_value;
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
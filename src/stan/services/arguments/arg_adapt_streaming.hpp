@@ -0,0 +1,26 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_ADAPT_STREAMING_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_ADAPT_STREAMING_HPP
+
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_adapt_streaming: public bool_argument {
+    public:
+      arg_adapt_streaming(): bool_argument() {
+        _name = "streaming";
+        _description = "Update the dense metric factor with each draw?";
+        _validity = "[0, 1]";
+        _default = "0";
+        _default_value = false;
+        _constrained = false;
+        _good_value = 1;
+        _value = _default_value;
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
@@ -10,7 +10,8 @@ namespace stan {
     public:
       arg_adapt_window(): u_int_argument() {
         _name = "window";
-        _description = "Initial width of slow adaptation interval";
+        _description = "Initial width of slow adaptation interval, "
+                       "or 0 to keep the metric fixed";
         _default = "25";
         _default_value = 25;
         _value = _default_value;
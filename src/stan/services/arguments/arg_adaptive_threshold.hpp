@@ -0,0 +1,30 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_ADAPTIVE_THRESHOLD_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_ADAPTIVE_THRESHOLD_HPP
+
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_adaptive_threshold: public real_argument {
+    public:
+      arg_adaptive_threshold(): real_argument() {
+        _name = "adaptive_threshold";
+        _description
+          = "Scale c of the implicit integrator threshold c |stepsize|^3";
+        _validity = "0 <= adaptive_threshold";
+        _default = "0";
+        _default_value = 0.0;
+        _constrained = true;
+        _good_value = 1.0;
+        _bad_value = -1.0;
+        _value = _default_value;
+      }
+
+      bool is_valid(double value) { return 0 <= value; }
+    };
+
+  }  // services
+}  // stan
+
+#endif
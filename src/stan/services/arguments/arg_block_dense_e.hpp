@@ -0,0 +1,23 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_BLOCK_DENSE_E_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_BLOCK_DENSE_E_HPP
+
+#include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/arg_block_dense_e_blocks.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_block_dense_e: public categorical_argument {
+    public:
+      arg_block_dense_e() {
+        _name = "block_dense_e";
+        _description = "Euclidean manifold with block diagonal metric";
+
+        _subarguments.push_back(new arg_block_dense_e_blocks());
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_BLOCK_DENSE_E_BLOCKS_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_BLOCK_DENSE_E_BLOCKS_HPP
+
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_block_dense_e_blocks: public string_argument {
+    public:
+      arg_block_dense_e_blocks(): string_argument() {
+        _name = "blocks";
+        _description = "Comma separated sizes of consecutive metric blocks, "
+                       "one block per parameter variable if empty";
+        _validity = "Positive sizes adding up to the number of parameters";
+        _default = "\"\"";
+        _default_value = "";
+        _constrained = false;
+        _good_value = "1";
+        _value = _default_value;
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
@@ -2,10 +2,14 @@
 #define STAN_SERVICES_ARGUMENTS_ARG_HMC_HPP
 
 #include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/arg_adaptive_threshold.hpp>
 #include <stan/services/arguments/arg_engine.hpp>
+#include <stan/services/arguments/arg_integrator.hpp>
 #include <stan/services/arguments/arg_metric.hpp>
+#include <stan/services/arguments/arg_metric_file.hpp>
 #include <stan/services/arguments/arg_stepsize.hpp>
 #include <stan/services/arguments/arg_stepsize_jitter.hpp>
+#include <stan/services/arguments/arg_stepsize_stride.hpp>
 
 namespace stan {
   namespace services {
@@ -18,8 +22,12 @@ namespace stan {
 
         _subarguments.push_back(new arg_engine());
         _subarguments.push_back(new arg_metric());
+        _subarguments.push_back(new arg_metric_file());
         _subarguments.push_back(new arg_stepsize());
         _subarguments.push_back(new arg_stepsize_jitter());
+        _subarguments.push_back(new arg_stepsize_stride());
+        _subarguments.push_back(new arg_integrator());
+        _subarguments.push_back(new arg_adaptive_threshold());
       }
     };
 
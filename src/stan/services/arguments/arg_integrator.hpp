@@ -0,0 +1,33 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_INTEGRATOR_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_INTEGRATOR_HPP
+
+#include <stan/services/arguments/list_argument.hpp>
+#include <stan/services/arguments/arg_leapfrog.hpp>
+#include <stan/services/arguments/arg_two_stage.hpp>
+#include <stan/services/arguments/arg_three_stage.hpp>
+#include <stan/services/arguments/arg_yoshida4.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_integrator: public list_argument {
+    public:
+      arg_integrator() {
+        _name = "integrator";
+        _description = "Symplectic integrator scheme";
+
+        _values.push_back(new arg_leapfrog());
+        _values.push_back(new arg_two_stage());
+        _values.push_back(new arg_three_stage());
+        _values.push_back(new arg_yoshida4());
+
+        _default_cursor = 0;
+        _cursor = _default_cursor;
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
+
@@ -0,0 +1,21 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_LEAPFROG_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_LEAPFROG_HPP
+
+#include <stan/services/arguments/unvalued_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_leapfrog: public unvalued_argument {
+    public:
+      arg_leapfrog() {
+        _name = "leapfrog";
+        _description = "Leapfrog (Stormer-Verlet) step, one gradient per step";
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
+
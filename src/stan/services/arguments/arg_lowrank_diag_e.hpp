@@ -0,0 +1,24 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_LOWRANK_DIAG_E_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_LOWRANK_DIAG_E_HPP
+
+#include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/arg_lowrank_diag_e_rank.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_lowrank_diag_e: public categorical_argument {
+    public:
+      arg_lowrank_diag_e() {
+        _name = "lowrank_diag_e";
+        _description
+          = "Euclidean manifold with low-rank plus diag metric";
+
+        _subarguments.push_back(new arg_lowrank_diag_e_rank());
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
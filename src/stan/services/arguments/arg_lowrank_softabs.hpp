@@ -0,0 +1,30 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_LOWRANK_SOFTABS_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_LOWRANK_SOFTABS_HPP
+
+#include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/arg_softabs_alpha.hpp>
+#include <stan/services/arguments/arg_lowrank_softabs_rank.hpp>
+#include <stan/services/arguments/arg_lowrank_softabs_tol.hpp>
+#include <stan/services/arguments/arg_lowrank_softabs_max_resolvent.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_lowrank_softabs: public categorical_argument {
+    public:
+      arg_lowrank_softabs() {
+        _name = "lowrank_softabs";
+        _description
+          = "Riemannian manifold with low-rank SoftAbs metric";
+
+        _subarguments.push_back(new arg_softabs_alpha());
+        _subarguments.push_back(new arg_lowrank_softabs_rank());
+        _subarguments.push_back(new arg_lowrank_softabs_tol());
+        _subarguments.push_back(new arg_lowrank_softabs_max_resolvent());
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_LOWRANK_SOFTABS_MAX_RESOLVENT_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_LOWRANK_SOFTABS_MAX_RESOLVENT_HPP
+
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_lowrank_softabs_max_resolvent: public int_argument {
+    public:
+      arg_lowrank_softabs_max_resolvent(): int_argument() {
+        _name = "max_resolvent";
+        _description
+          = "Hessian-vector products per resolvent solve before the "
+            "trajectory is rejected, or 0 for twice the dimension";
+        _validity = "0 <= max_resolvent";
+        _default = "0";
+        _default_value = 0;
+        _constrained = true;
+        _good_value = 10.0;
+        _bad_value = -1.0;
+        _value = _default_value;
+      }
+
+      bool is_valid(int value) { return value >= 0; }
+    };
+
+  }  // services
+}  // stan
+
+#endif
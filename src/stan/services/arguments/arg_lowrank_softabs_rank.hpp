@@ -0,0 +1,29 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_LOWRANK_SOFTABS_RANK_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_LOWRANK_SOFTABS_RANK_HPP
+
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_lowrank_softabs_rank: public int_argument {
+    public:
+      arg_lowrank_softabs_rank(): int_argument() {
+        _name = "rank";
+        _description = "Number of curvature directions kept";
+        _validity = "0 <= rank";
+        _default = "10";
+        _default_value = 10;
+        _constrained = true;
+        _good_value = 2.0;
+        _bad_value = -1.0;
+        _value = _default_value;
+      }
+
+      bool is_valid(int value) { return value >= 0; }
+    };
+
+  }  // services
+}  // stan
+
+#endif
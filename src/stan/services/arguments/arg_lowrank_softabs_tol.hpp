@@ -0,0 +1,30 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_LOWRANK_SOFTABS_TOL_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_LOWRANK_SOFTABS_TOL_HPP
+
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_lowrank_softabs_tol: public real_argument {
+    public:
+      arg_lowrank_softabs_tol(): real_argument() {
+        _name = "tol";
+        _description
+          = "Relative residual of the eigenpair and resolvent solves";
+        _validity = "0 <= tol";
+        _default = "1e-10";
+        _default_value = 1e-10;
+        _constrained = true;
+        _good_value = 1e-8;
+        _bad_value = -1.0;
+        _value = _default_value;
+      }
+
+      bool is_valid(double value) { return value >= 0; }
+    };
+
+  }  // services
+}  // stan
+
+#endif
@@ -5,6 +5,10 @@
 #include <stan/services/arguments/arg_unit_e.hpp>
 #include <stan/services/arguments/arg_diag_e.hpp>
 #include <stan/services/arguments/arg_dense_e.hpp>
+#include <stan/services/arguments/arg_lowrank_diag_e.hpp>
+#include <stan/services/arguments/arg_block_dense_e.hpp>
+#include <stan/services/arguments/arg_softabs.hpp>
+#include <stan/services/arguments/arg_lowrank_softabs.hpp>
 
 namespace stan {
   namespace services {
@@ -18,6 +22,10 @@ namespace stan {
         _values.push_back(new arg_unit_e());
         _values.push_back(new arg_diag_e());
         _values.push_back(new arg_dense_e());
+        _values.push_back(new arg_lowrank_diag_e());
+        _values.push_back(new arg_block_dense_e());
+        _values.push_back(new arg_softabs());
+        _values.push_back(new arg_lowrank_softabs());
 
         _default_cursor = 1;
         _cursor = _default_cursor;
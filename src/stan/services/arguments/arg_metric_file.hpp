@@ -0,0 +1,27 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_METRIC_FILE_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_METRIC_FILE_HPP
+
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_metric_file: public string_argument {
+    public:
+      arg_metric_file(): string_argument() {
+        _name = "metric_file";
+        _description = "Input file with the step size and inverse metric "
+                       "adapted by an earlier run";
+        _validity = "Path to existing file";
+        _default = "\"\"";
+        _default_value = "";
+        _constrained = false;
+        _good_value = "good";
+        _value = _default_value;
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_STEPSIZE_STRIDE_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_STEPSIZE_STRIDE_HPP
+
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_stepsize_stride: public int_argument {
+    public:
+      arg_stepsize_stride(): int_argument() {
+        _name = "stepsize_stride";
+        _description
+          = "Doublings per probe of the initial stepsize search";
+        _validity = "0 < stepsize_stride";
+        _default = "1";
+        _default_value = 1;
+        _constrained = true;
+        _good_value = 4.0;
+        _bad_value = 0.0;
+        _value = _default_value;
+      }
+
+      bool is_valid(int value) { return value > 0; }
+    };
+
+  }  // services
+}  // stan
+
+#endif
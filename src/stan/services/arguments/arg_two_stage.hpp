@@ -0,0 +1,21 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_TWO_STAGE_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_TWO_STAGE_HPP
+
+#include <stan/services/arguments/unvalued_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_two_stage: public unvalued_argument {
+    public:
+      arg_two_stage() {
+        _name = "two_stage";
+        _description = "Minimum-error two-stage splitting, two gradients per step";
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
+
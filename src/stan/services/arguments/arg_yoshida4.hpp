@@ -0,0 +1,21 @@
+#ifndef STAN_SERVICES_ARGUMENTS_ARG_YOSHIDA4_HPP
+#define STAN_SERVICES_ARGUMENTS_ARG_YOSHIDA4_HPP
+
+#include <stan/services/arguments/unvalued_argument.hpp>
+
+namespace stan {
+  namespace services {
+
+    class arg_yoshida4: public unvalued_argument {
+    public:
+      arg_yoshida4() {
+        _name = "yoshida4";
+        _description = "Fourth-order Yoshida composition, three gradients per step";
+      }
+    };
+
+  }  // services
+}  // stan
+
+#endif
+
@@ -0,0 +1,45 @@
+#ifndef STAN_SERVICES_MCMC_CREATE_CHAIN_RNGS_HPP
+#define STAN_SERVICES_MCMC_CREATE_CHAIN_RNGS_HPP
+
+#include <boost/cstdint.hpp>
+#include <vector>
+
+namespace stan {
+  namespace services {
+    namespace mcmc {
+
+      /**
+       * Number of draws skipped between the random number streams
+       * of consecutive chains.
+       */
+      static const boost::uintmax_t chain_rng_discard_stride
+        = static_cast<boost::uintmax_t>(1) << 50;
+
+      /**
+       * Creates one random number generator per chain, all seeded
+       * with the same seed and advanced by a fixed stride so that
+       * the chains draw from non-overlapping streams.  Chain 0 uses
+       * the unadvanced stream.
+       *
+       * @tparam RNG Random number generator class
+       * @param[in] seed Seed shared by all chains
+       * @param[in] num_chains Number of chains
+       * @param[out] rngs Random number generators, one per chain
+       */
+      template <class RNG>
+      void create_chain_rngs(unsigned int seed, int num_chains,
+                             std::vector<RNG>& rngs) {
+        rngs.clear();
+        rngs.reserve(num_chains);
+        for (int c = 0; c < num_chains; ++c) {
+          RNG rng(seed);
+          rng.discard(chain_rng_discard_stride * c);
+          rngs.push_back(rng);
+        }
+      }
+
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef STAN_SERVICES_MCMC_POOL_ADAPTATION_HPP
+#define STAN_SERVICES_MCMC_POOL_ADAPTATION_HPP
+
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/covar_adaptation.hpp>
+#include <stan/mcmc/stepsize_adaptation.hpp>
+#include <stan/mcmc/stepsize_adapter.hpp>
+#include <stan/mcmc/stepsize_covar_adapter.hpp>
+#include <stan/mcmc/stepsize_var_adapter.hpp>
+#include <stan/mcmc/var_adaptation.hpp>
+#include <vector>
+
+namespace stan {
+  namespace services {
+    namespace mcmc {
+
+      /**
+       * Links the warmup adaptation of several chains so that they
+       * pool their metric estimates and dual averaging statistics at
+       * every window boundary and when adaptation completes.
+       *
+       * The samplers must be advanced in lockstep, as by
+       * run_chains, and share the same window parameters.  Samplers
+       * without adaptation are ignored.
+       *
+       * @param samplers Samplers, one per chain
+       */
+      inline void
+      pool_adaptation(std::vector<stan::mcmc::base_mcmc*>& samplers) {
+        std::vector<stan::mcmc::stepsize_adaptation*> stepsize_pool;
+        std::vector<stan::mcmc::var_adaptation*> var_pool;
+        std::vector<stan::mcmc::covar_adaptation*> covar_pool;
+
+        for (size_t c = 0; c < samplers.size(); ++c) {
+          if (stan::mcmc::stepsize_var_adapter* adapter
+              = dynamic_cast<stan::mcmc::stepsize_var_adapter*>(samplers[c])) {
+            stepsize_pool.push_back(&adapter->get_stepsize_adaptation());
+            var_pool.push_back(&adapter->get_var_adaptation());
+          } else if (stan::mcmc::stepsize_covar_adapter* adapter
+                     = dynamic_cast<stan::mcmc::stepsize_covar_adapter*>
+                     (samplers[c])) {
+            stepsize_pool.push_back(&adapter->get_stepsize_adaptation());
+            covar_pool.push_back(&adapter->get_covar_adaptation());
+          } else if (stan::mcmc::stepsize_adapter* adapter
+                     = dynamic_cast<stan::mcmc::stepsize_adapter*>
+                     (samplers[c])) {
+            stepsize_pool.push_back(&adapter->get_stepsize_adaptation());
+          }
+        }
+
+        for (size_t c = 0; c < stepsize_pool.size(); ++c)
+          stepsize_pool[c]->set_pool(stepsize_pool);
+        for (size_t c = 0; c < var_pool.size(); ++c)
+          var_pool[c]->set_pool(var_pool);
+        for (size_t c = 0; c < covar_pool.size(); ++c)
+          covar_pool[c]->set_pool(covar_pool);
+      }
+
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef STAN_SERVICES_MCMC_RUN_CHAINS_HPP
+#define STAN_SERVICES_MCMC_RUN_CHAINS_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/mcmc/base_adapter.hpp>
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/model/counting_model.hpp>
+#include <stan/services/sample/mcmc_writer.hpp>
+#include <stan/services/sample/progress.hpp>
+#include <ctime>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace services {
+    namespace mcmc {
+
+      /**
+       * Advances every chain by num_iterations transitions, one
+       * iteration of each chain at a time, accumulating the CPU time
+       * spent on each chain in delta_t.  Stops early, after writing
+       * the message to the info writer, if the callback throws
+       * gradient_budget_exhausted.
+       */
+      template <class Model, class RNG, class StartTransitionCallback,
+                class SampleRecorder, class DiagnosticRecorder,
+                class MessageRecorder>
+      void generate_chain_transitions(
+        std::vector<stan::mcmc::base_mcmc*>& samplers,
+        const int num_iterations,
+        const int start,
+        const int finish,
+        const int num_thin,
+        const int refresh,
+        const bool save,
+        const bool warmup,
+        std::vector<stan::services::sample::mcmc_writer<
+        Model, SampleRecorder, DiagnosticRecorder, MessageRecorder>*>&
+        mcmc_writers,
+        std::vector<stan::mcmc::sample>& init_s,
+        Model& model,
+        std::vector<RNG>& base_rngs,
+        const std::vector<std::string>& prefixes,
+        const std::string& suffix,
+        std::ostream& o,
+        StartTransitionCallback& callback,
+        interface_callbacks::writer::base_writer& info_writer,
+        interface_callbacks::writer::base_writer& error_writer,
+        std::vector<double>& delta_t) {
+        const size_t num_chains = samplers.size();
+
+        for (int m = 0; m < num_iterations; ++m) {
+          for (size_t c = 0; c < num_chains; ++c) {
+            try {
+              callback();
+            } catch (const stan::model::gradient_budget_exhausted& e) {
+              info_writer(e.what());
+              return;
+            }
+
+            clock_t chain_start = clock();
+
+            sample::progress(m, start, finish, refresh, warmup,
+                             prefixes[c], suffix, o);
+
+            init_s[c] = samplers[c]->transition(init_s[c],
+                                                info_writer, error_writer);
+
+            if ( save && ( (m % num_thin) == 0) ) {
+              mcmc_writers[c]->write_sample_params(base_rngs[c], init_s[c],
+                                                   *samplers[c], model);
+              mcmc_writers[c]->write_diagnostic_params(init_s[c],
+                                                       samplers[c]);
+            }
+
+            delta_t[c] += static_cast<double>(clock() - chain_start)
+              / CLOCKS_PER_SEC;
+          }
+        }
+      }
+
+      /**
+       * Runs warmup and sampling for several chains of the same
+       * model within one process, so that data is read and
+       * transformed data is computed only once.
+       *
+       * Each chain has its own sampler, random number generator,
+       * initial sample and mcmc_writer; the samplers must have been
+       * constructed with the corresponding element of base_rngs.
+       * Chains are advanced in lockstep, one iteration of every
+       * chain at a time, on the calling thread: the reverse mode
+       * autodiff stack is shared process-wide, so gradient
+       * evaluations of different chains cannot run concurrently.
+       *
+       * Adaptive samplers are disengaged after warmup and their
+       * adapted state is written to the chain's writer.  The CPU
+       * time spent on each chain is written to its writer and
+       * returned in warm_delta_t and sample_delta_t.
+       *
+       * @param samplers Samplers, one per chain
+       * @param num_warmup Number of warmup iterations
+       * @param num_samples Number of sampling iterations
+       * @param num_thin Period between saved samples
+       * @param refresh Period between progress messages
+       * @param save_warmup Whether to save warmup iterations
+       * @param mcmc_writers Writers, one per chain
+       * @param init_s Initial samples, one per chain; on output the
+       *   final samples
+       * @param model Model shared by all chains
+       * @param base_rngs Random number generators, one per chain
+       * @param prefix Prefix for progress messages
+       * @param suffix Suffix for progress messages
+       * @param o Stream for progress messages
+       * @param callback Called before every transition
+       * @param info_writer Writer for information messages
+       * @param error_writer Writer for error messages
+       * @param warm_delta_t Warmup time of each chain in seconds
+       * @param sample_delta_t Sampling time of each chain in seconds
+       */
+      template <class Model, class RNG, class StartTransitionCallback,
+                class SampleRecorder, class DiagnosticRecorder,
+                class MessageRecorder>
+      void run_chains(std::vector<stan::mcmc::base_mcmc*>& samplers,
+                      int num_warmup,
+                      int num_samples,
+                      int num_thin,
+                      int refresh,
+                      bool save_warmup,
+                      std::vector<stan::services::sample::mcmc_writer<
+                      Model, SampleRecorder, DiagnosticRecorder,
+                      MessageRecorder>*>& mcmc_writers,
+                      std::vector<stan::mcmc::sample>& init_s,
+                      Model& model,
+                      std::vector<RNG>& base_rngs,
+                      const std::string& prefix,
+                      const std::string& suffix,
+                      std::ostream& o,
+                      StartTransitionCallback& callback,
+                      interface_callbacks::writer::base_writer& info_writer,
+                      interface_callbacks::writer::base_writer& error_writer,
+                      std::vector<double>& warm_delta_t,
+                      std::vector<double>& sample_delta_t) {
+        const size_t num_chains = samplers.size();
+
+        std::vector<std::string> prefixes(num_chains);
+        for (size_t c = 0; c < num_chains; ++c) {
+          std::stringstream ss;
+          ss << prefix << "Chain " << c + 1 << ": ";
+          prefixes[c] = ss.str();
+        }
+
+        warm_delta_t.assign(num_chains, 0);
+        sample_delta_t.assign(num_chains, 0);
+
+        generate_chain_transitions<Model, RNG, StartTransitionCallback,
+                                   SampleRecorder, DiagnosticRecorder,
+                                   MessageRecorder>
+          (samplers, num_warmup, 0, num_warmup + num_samples, num_thin,
+           refresh, save_warmup, true,
+           mcmc_writers,
+           init_s, model, base_rngs,
+           prefixes, suffix, o,
+           callback, info_writer, error_writer, warm_delta_t);
+
+        for (size_t c = 0; c < num_chains; ++c) {
+          stan::mcmc::base_adapter* adapter
+            = dynamic_cast<stan::mcmc::base_adapter*>(samplers[c]);
+          if (adapter && adapter->adapting()) {
+            adapter->disengage_adaptation();
+            mcmc_writers[c]->write_adapt_finish(samplers[c]);
+          }
+        }
+
+        generate_chain_transitions<Model, RNG, StartTransitionCallback,
+                                   SampleRecorder, DiagnosticRecorder,
+                                   MessageRecorder>
+          (samplers, num_samples, num_warmup, num_warmup + num_samples,
+           num_thin, refresh, true, false,
+           mcmc_writers,
+           init_s, model, base_rngs,
+           prefixes, suffix, o,
+           callback, info_writer, error_writer, sample_delta_t);
+
+        for (size_t c = 0; c < num_chains; ++c)
+          mcmc_writers[c]->write_timing(warm_delta_t[c], sample_delta_t[c]);
+      }
+
+    }
+  }
+}
+
+#endif
@@ -31,7 +31,10 @@ namespace stan {
                   std::ostream& o,
                   StartTransitionCallback& callback,
                   interface_callbacks::writer::base_writer& info_writer,
-                  interface_callbacks::writer::base_writer& error_writer) {
+                  interface_callbacks::writer::base_writer& error_writer,
+                  stan::mcmc::transition_profile* profile = 0,
+                  stan::services::sample::chain_checkpoint* checkpoint
+                  = 0) {
         stan::services::sample::generate_transitions<Model, RNG,
                                                      StartTransitionCallback,
                                                      SampleRecorder,
@@ -42,7 +45,7 @@ namespace stan {
            mcmc_writer,
            init_s, model, base_rng,
            prefix, suffix, o,
-           callback, info_writer, error_writer);
+           callback, info_writer, error_writer, profile, 0, checkpoint);
       }
 
     }
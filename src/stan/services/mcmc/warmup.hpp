@@ -10,36 +10,49 @@ namespace stan {
   namespace services {
     namespace mcmc {
 
+      /**
+       * Runs warmup, ending early when the optional warmup
+       * controller finds adaptation has stabilized, and saving or
+       * resuming the chain with the optional checkpoint.
+       *
+       * @return Number of warmup iterations run
+       */
       template <class Model, class RNG, class StartTransitionCallback,
                 class SampleRecorder, class DiagnosticRecorder,
                 class MessageRecorder>
-      void warmup(stan::mcmc::base_mcmc* sampler,
-                  int num_warmup,
-                  int num_samples,
-                  int num_thin,
-                  int refresh,
-                  bool save,
-                  stan::services::sample::mcmc_writer<
-                  Model, SampleRecorder, DiagnosticRecorder, MessageRecorder>&
-                  mcmc_writer,
-                  stan::mcmc::sample& init_s,
-                  Model& model,
-                  RNG& base_rng,
-                  const std::string& prefix,
-                  const std::string& suffix,
-                  std::ostream& o,
-                  StartTransitionCallback& callback,
-                  interface_callbacks::writer::base_writer& info_writer,
-                  interface_callbacks::writer::base_writer& error_writer) {
-        sample::generate_transitions<Model, RNG, StartTransitionCallback,
-                                     SampleRecorder, DiagnosticRecorder,
-                                     MessageRecorder>
+      int warmup(stan::mcmc::base_mcmc* sampler,
+                 int num_warmup,
+                 int num_samples,
+                 int num_thin,
+                 int refresh,
+                 bool save,
+                 stan::services::sample::mcmc_writer<
+                 Model, SampleRecorder, DiagnosticRecorder, MessageRecorder>&
+                 mcmc_writer,
+                 stan::mcmc::sample& init_s,
+                 Model& model,
+                 RNG& base_rng,
+                 const std::string& prefix,
+                 const std::string& suffix,
+                 std::ostream& o,
+                 StartTransitionCallback& callback,
+                 interface_callbacks::writer::base_writer& info_writer,
+                 interface_callbacks::writer::base_writer& error_writer,
+                 stan::mcmc::transition_profile* profile = 0,
+                 stan::mcmc::warmup_controller* controller = 0,
+                 stan::services::sample::chain_checkpoint* checkpoint = 0) {
+        return sample::generate_transitions<Model, RNG,
+                                            StartTransitionCallback,
+                                            SampleRecorder,
+                                            DiagnosticRecorder,
+                                            MessageRecorder>
           (sampler, num_warmup, 0, num_warmup + num_samples, num_thin,
            refresh, save, true,
            mcmc_writer,
            init_s, model, base_rng,
            prefix, suffix, o,
-           callback, info_writer, error_writer);
+           callback, info_writer, error_writer, profile, controller,
+           checkpoint);
       }
 
     }
@@ -2,6 +2,7 @@
 #define STAN_SERVICES_OPTIMIZE_DO_BFGS_OPTIMIZE_HPP
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/model/counting_model.hpp>
 #include <stan/optimization/bfgs.hpp>
 #include <stan/services/error_codes.hpp>
 #include <stan/services/io/do_print.hpp>
@@ -16,6 +17,16 @@ namespace stan {
   namespace services {
     namespace optimize {
 
+      /**
+       * Runs a BFGS or L-BFGS optimizer to termination, calling
+       * interrupt before every iteration.
+       *
+       * If interrupt throws gradient_budget_exhausted, the
+       * optimization ends with an error: the budget is reported to
+       * the info writer, lp and cont_vector hold the last iterate,
+       * which is written to output unless every iteration already
+       * was, and error_codes::SOFTWARE is returned.
+       */
       template<typename Model, typename BFGSOptimizer, typename RNGT,
                typename StartIterationCallback>
       int do_bfgs_optimize(Model &model, BFGSOptimizer &bfgs,
@@ -43,7 +54,19 @@ namespace stan {
         int ret = 0;
 
         while (ret == 0) {
-          interrupt();
+          try {
+            interrupt();
+          } catch (const stan::model::gradient_budget_exhausted& e) {
+            info("Optimization terminated with error: ");
+            info("  " + std::string(e.what()));
+            if (!save_iterations) {
+              io::write_iteration(model, base_rng,
+                                  lp, cont_vector, disc_vector,
+                                  info, output);
+            }
+            return stan::services::error_codes::SOFTWARE;
+          }
+
           if (io::do_print(bfgs.iter_num(), 50*refresh)) {
             info("    Iter "
                  "     log prob "
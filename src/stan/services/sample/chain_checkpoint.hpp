@@ -0,0 +1,205 @@
+#ifndef STAN_SERVICES_SAMPLE_CHAIN_CHECKPOINT_HPP
+#define STAN_SERVICES_SAMPLE_CHAIN_CHECKPOINT_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/mcmc/base_adapter.hpp>
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/chain_state.hpp>
+#include <stan/mcmc/sample.hpp>
+#include <stan/mcmc/warmup_controller.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace stan {
+  namespace services {
+    namespace sample {
+
+      /**
+       * Saves the state of a chain every interval iterations so an
+       * interrupted run can resume without redoing warmup.
+       *
+       * Each snapshot holds the phase and iteration, the last draw,
+       * the sampler state, the state of its adaptation and of the
+       * warmup controller, and the RNG state.  It is written as one
+       * string to the writer, which only needs to keep the latest.
+       *
+       * To resume, pass that string to resume_from() and rerun the
+       * same service with the same configuration.  The first call
+       * to generate_transitions restores the snapshot and skips the
+       * iterations it covers, so the chain continues exactly.  Draws
+       * written after the snapshot and before the interruption are
+       * written again.
+       */
+      class chain_checkpoint {
+      public:
+        /**
+         * @param interval Number of iterations between snapshots,
+         *   or 0 to only restore
+         * @param writer Writer receiving each snapshot
+         */
+        chain_checkpoint(int interval,
+                         interface_callbacks::writer::base_writer& writer)
+          : interval_(interval), writer_(writer), num_warmup_(0),
+            resuming_(false), saved_warmup_(false), saved_iteration_(0) {}
+
+        /**
+         * Sets a snapshot to restore at the next call of
+         * generate_transitions.
+         */
+        void resume_from(const std::string& state) {
+          resume_state_ = state;
+        }
+
+        bool due(int iteration) {
+          return interval_ > 0 && iteration % interval_ == 0;
+        }
+
+        /**
+         * Records the number of warmup iterations run, as warmup can
+         * end early.
+         */
+        void set_num_warmup(int n) {
+          num_warmup_ = n;
+        }
+
+        template <class RNG>
+        void save(bool warmup, int iteration,
+                  stan::mcmc::base_mcmc* sampler,
+                  const stan::mcmc::sample& s,
+                  RNG& rng,
+                  stan::mcmc::warmup_controller* controller) {
+          std::stringstream state;
+          state << "stan_chain_state 1 " << (warmup ? 1 : 0) << ' '
+                << iteration << ' ' << num_warmup_ << ' ';
+
+          stan::mcmc::write_chain_state(state, s.cont_params());
+          stan::mcmc::write_chain_state(state, s.log_prob());
+          stan::mcmc::write_chain_state(state, s.accept_stat());
+
+          sampler->write_state(state);
+
+          stan::mcmc::base_adapter* adapter
+            = dynamic_cast<stan::mcmc::base_adapter*>(sampler);
+          state << (adapter ? 1 : 0) << ' ';
+          if (adapter)
+            adapter->write_adaptation_state(state);
+
+          state << (controller ? 1 : 0) << ' ';
+          if (controller)
+            controller->write_state(state);
+
+          state << rng;
+          writer_(state.str());
+        }
+
+        /**
+         * Restores the snapshot set by resume_from(), if any, at the
+         * first call of a phase.
+         *
+         * @param[in] warmup Whether the phase is warmup
+         * @param[out] iteration Number of iterations of the phase
+         *   already run
+         * @return true if the snapshot was taken after the phase,
+         *   which should then be skipped
+         * @throw std::domain_error if the snapshot is corrupt or
+         *   does not match the configuration
+         */
+        template <class RNG>
+        bool resume(bool warmup, int& iteration,
+                    stan::mcmc::base_mcmc* sampler,
+                    stan::mcmc::sample& s,
+                    RNG& rng,
+                    stan::mcmc::warmup_controller* controller) {
+          if (!resume_state_.empty()) {
+            restore_(sampler, s, rng, controller);
+            resume_state_.clear();
+            resuming_ = true;
+          }
+
+          if (!resuming_)
+            return false;
+
+          if (warmup && !saved_warmup_) {
+            iteration = num_warmup_;
+            return true;
+          }
+
+          resuming_ = false;
+          iteration = saved_iteration_;
+          return false;
+        }
+
+      private:
+        int interval_;
+        interface_callbacks::writer::base_writer& writer_;
+        int num_warmup_;
+
+        std::string resume_state_;
+        bool resuming_;
+        bool saved_warmup_;
+        int saved_iteration_;
+
+        template <class RNG>
+        void restore_(stan::mcmc::base_mcmc* sampler,
+                      stan::mcmc::sample& s,
+                      RNG& rng,
+                      stan::mcmc::warmup_controller* controller) {
+          std::stringstream state(resume_state_);
+
+          std::string tag;
+          int version = 0;
+          if (!(state >> tag >> version) || tag != "stan_chain_state")
+            throw std::domain_error("Chain state is truncated or corrupt");
+          if (version != 1)
+            throw std::domain_error("Unsupported chain state version");
+
+          int warmup = 0;
+          if (!(state >> warmup >> saved_iteration_ >> num_warmup_))
+            throw std::domain_error("Chain state is truncated or corrupt");
+          saved_warmup_ = warmup != 0;
+
+          Eigen::VectorXd cont_params;
+          double log_prob;
+          double accept_stat;
+          stan::mcmc::read_chain_state(state, cont_params, s.size_cont());
+          stan::mcmc::read_chain_state(state, log_prob);
+          stan::mcmc::read_chain_state(state, accept_stat);
+          s = stan::mcmc::sample(cont_params, log_prob, accept_stat);
+
+          sampler->read_state(state);
+
+          stan::mcmc::base_adapter* adapter
+            = dynamic_cast<stan::mcmc::base_adapter*>(sampler);
+          int has_adapter = 0;
+          state >> has_adapter;
+          if (has_adapter != (adapter ? 1 : 0))
+            throw std::domain_error("Chain state does not match the "
+                                    "sampler");
+          if (adapter)
+            adapter->read_adaptation_state(state);
+
+          // Warmup must run with a controller exactly when the
+          // snapshot has one; sampling ignores the controller
+          int has_controller = 0;
+          state >> has_controller;
+          bool mismatch = saved_warmup_
+                          ? has_controller != (controller ? 1 : 0)
+                          : has_controller && !controller;
+          if (mismatch)
+            throw std::domain_error("Chain state does not match the "
+                                    "warmup configuration");
+          if (has_controller)
+            controller->read_state(state);
+
+          if (!(state >> rng))
+            throw std::domain_error("Chain state is truncated or corrupt");
+        }
+      };
+
+    }
+  }
+}
+
+#endif
@@ -3,6 +3,10 @@
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
 #include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/transition_profile.hpp>
+#include <stan/mcmc/warmup_controller.hpp>
+#include <stan/model/counting_model.hpp>
+#include <stan/services/sample/chain_checkpoint.hpp>
 #include <stan/services/sample/mcmc_writer.hpp>
 #include <stan/services/sample/progress.hpp>
 #include <string>
@@ -11,44 +15,102 @@ namespace stan {
   namespace services {
     namespace sample {
 
+      /**
+       * Runs num_iterations transitions of the sampler, or fewer if
+       * the warmup controller, when given, ends warmup early or the
+       * callback throws gradient_budget_exhausted.  The exhausted
+       * budget is reported to the info writer and the phase ends
+       * normally, with every draw before it written.
+       *
+       * With a checkpoint the state of the chain is saved at its
+       * interval, and a snapshot set to resume from is restored
+       * before the first transition, skipping the iterations it
+       * covers.
+       *
+       * @return Number of transitions run, including those skipped
+       *   when resuming
+       */
       template <class Model, class RNG, class StartTransitionCallback,
                 class SampleRecorder, class DiagnosticRecorder,
                 class MessageRecorder>
-      void generate_transitions(stan::mcmc::base_mcmc* sampler,
-                                const int num_iterations,
-                                const int start,
-                                const int finish,
-                                const int num_thin,
-                                const int refresh,
-                                const bool save,
-                                const bool warmup,
-                                stan::services::sample::mcmc_writer<
-                                Model, SampleRecorder,
-                                DiagnosticRecorder, MessageRecorder>&
-                                mcmc_writer,
-                                stan::mcmc::sample& init_s,
-                                Model& model,
-                                RNG& base_rng,
-                                const std::string& prefix,
-                                const std::string& suffix,
-                                std::ostream& o,
-                                StartTransitionCallback& callback,
-                                interface_callbacks::writer::base_writer&
-                                info_writer,
-                                interface_callbacks::writer::base_writer&
-                                error_writer) {
-        for (int m = 0; m < num_iterations; ++m) {
-          callback();
+      int generate_transitions(stan::mcmc::base_mcmc* sampler,
+                               const int num_iterations,
+                               const int start,
+                               const int finish,
+                               const int num_thin,
+                               const int refresh,
+                               const bool save,
+                               const bool warmup,
+                               stan::services::sample::mcmc_writer<
+                               Model, SampleRecorder,
+                               DiagnosticRecorder, MessageRecorder>&
+                               mcmc_writer,
+                               stan::mcmc::sample& init_s,
+                               Model& model,
+                               RNG& base_rng,
+                               const std::string& prefix,
+                               const std::string& suffix,
+                               std::ostream& o,
+                               StartTransitionCallback& callback,
+                               interface_callbacks::writer::base_writer&
+                               info_writer,
+                               interface_callbacks::writer::base_writer&
+                               error_writer,
+                               stan::mcmc::transition_profile* profile = 0,
+                               stan::mcmc::warmup_controller* controller
+                               = 0,
+                               chain_checkpoint* checkpoint = 0) {
+        typedef stan::mcmc::transition_profile profile_t;
+
+        int m = 0;
+        if (checkpoint && checkpoint->resume(warmup, m, sampler, init_s,
+                                             base_rng, controller))
+          return m;
+
+        if (profile)
+          sampler->set_profile(profile);
+
+        while (m < num_iterations) {
+          try {
+            callback();
+          } catch (const stan::model::gradient_budget_exhausted& e) {
+            info_writer(e.what());
+            break;
+          }
 
           progress(m, start, finish, refresh, warmup, prefix, suffix, o);
 
+          if (profile) profile->begin(profile_t::transition_phase);
           init_s = sampler->transition(init_s, info_writer, error_writer);
+          if (profile) profile->end(profile_t::transition_phase);
 
           if ( save && ( (m % num_thin) == 0) ) {
-            mcmc_writer.write_sample_params(base_rng, init_s, *sampler, model);
+            if (profile) profile->begin(profile_t::output_phase);
+            mcmc_writer.write_sample_params(base_rng, init_s, *sampler, model,
+                                            profile);
             mcmc_writer.write_diagnostic_params(init_s, sampler);
+            if (profile) profile->end(profile_t::output_phase);
           }
+
+          if (profile) profile->end_iteration();
+
+          ++m;
+          bool stop = controller && controller->update();
+
+          if (checkpoint && checkpoint->due(m))
+            checkpoint->save(warmup, m, sampler, init_s, base_rng,
+                             controller);
+          if (stop)
+            break;
         }
+
+        if (profile)
+          sampler->set_profile(0);
+
+        if (checkpoint && warmup)
+          checkpoint->set_num_warmup(m);
+
+        return m;
       }
 
     }
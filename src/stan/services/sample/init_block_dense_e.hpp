@@ -0,0 +1,64 @@
+#ifndef STAN_SERVICES_SAMPLE_INIT_BLOCK_DENSE_E_HPP
+#define STAN_SERVICES_SAMPLE_INIT_BLOCK_DENSE_E_HPP
+
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/stepsize_block_covar_adapter.hpp>
+#include <stan/mcmc/hmc/hamiltonians/metric_blocks.hpp>
+#include <stan/services/arguments/argument.hpp>
+#include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/singleton_argument.hpp>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace services {
+    namespace sample {
+
+      /**
+       * Sets the metric blocks of a block-diagonal sampler and of its
+       * adaptation, if any, either from the blocks argument or, when
+       * that is empty, one block per parameter variable of the model.
+       * Returns false unless the metric argument selects
+       * block_dense_e.
+       */
+      template<class Sampler, class Model>
+      bool init_block_dense_e(stan::mcmc::base_mcmc* sampler,
+                              stan::services::argument* algorithm,
+                              const Model& model) {
+        stan::services::categorical_argument* hmc
+          = dynamic_cast<stan::services::categorical_argument*>
+          (algorithm->arg("hmc"));
+
+        stan::services::argument* metric
+          = hmc->arg("metric")->arg("block_dense_e");
+        if (!metric)
+          return false;
+
+        std::string spec
+          = dynamic_cast<stan::services::string_argument*>
+          (metric->arg("blocks"))->value();
+
+        std::vector<int> sizes;
+        if (spec.empty()) {
+          std::vector<std::string> names;
+          model.unconstrained_param_names(names, false, false);
+          stan::mcmc::metric_blocks_from_names(names, sizes);
+        } else {
+          stan::mcmc::metric_blocks_from_string(spec, sizes);
+        }
+
+        dynamic_cast<Sampler*>(sampler)->z().set_blocks(sizes);
+
+        stan::mcmc::stepsize_block_covar_adapter* adapter
+          = dynamic_cast<stan::mcmc::stepsize_block_covar_adapter*>(sampler);
+        if (adapter)
+          adapter->get_block_covar_adaptation().set_blocks(sizes);
+
+        return true;
+      }
+
+    }
+  }
+}
+
+#endif
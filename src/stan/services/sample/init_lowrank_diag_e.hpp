@@ -0,0 +1,47 @@
+#ifndef STAN_SERVICES_SAMPLE_INIT_LOWRANK_DIAG_E_HPP
+#define STAN_SERVICES_SAMPLE_INIT_LOWRANK_DIAG_E_HPP
+
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/stepsize_lowrank_var_adapter.hpp>
+#include <stan/services/arguments/argument.hpp>
+#include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+    namespace sample {
+
+      /**
+       * Sets the rank of the low-rank variance adaptation of an
+       * adaptive low-rank sampler; the fixed metric samplers have
+       * nothing to set.  Returns false unless the metric argument
+       * selects lowrank_diag_e.
+       */
+      template<class Sampler>
+      bool init_lowrank_diag_e(stan::mcmc::base_mcmc* sampler,
+                               stan::services::argument* algorithm) {
+        stan::services::categorical_argument* hmc
+          = dynamic_cast<stan::services::categorical_argument*>
+          (algorithm->arg("hmc"));
+        stan::services::argument* metric
+          = hmc->arg("metric")->arg("lowrank_diag_e");
+        if (!metric)
+          return false;
+
+        int rank
+          = dynamic_cast<stan::services::int_argument*>
+          (metric->arg("rank"))->value();
+
+        stan::mcmc::stepsize_lowrank_var_adapter* adapter
+          = dynamic_cast<stan::mcmc::stepsize_lowrank_var_adapter*>(sampler);
+        if (adapter)
+          adapter->get_lowrank_var_adaptation().set_rank(rank);
+
+        return true;
+      }
+
+    }
+  }
+}
+
+#endif
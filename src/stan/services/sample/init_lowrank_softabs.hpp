@@ -0,0 +1,55 @@
+#ifndef STAN_SERVICES_SAMPLE_INIT_LOWRANK_SOFTABS_HPP
+#define STAN_SERVICES_SAMPLE_INIT_LOWRANK_SOFTABS_HPP
+
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/services/arguments/argument.hpp>
+#include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+    namespace sample {
+
+      /**
+       * Sets the regularization, rank and solver controls of a
+       * low-rank SoftAbs sampler.  Returns false unless the metric
+       * argument selects lowrank_softabs.
+       */
+      template<class Sampler>
+      bool init_lowrank_softabs(stan::mcmc::base_mcmc* sampler,
+                                stan::services::argument* algorithm) {
+        stan::services::categorical_argument* hmc
+          = dynamic_cast<stan::services::categorical_argument*>
+          (algorithm->arg("hmc"));
+        stan::services::argument* metric
+          = hmc->arg("metric")->arg("lowrank_softabs");
+        if (!metric)
+          return false;
+
+        double alpha
+          = dynamic_cast<stan::services::real_argument*>
+          (metric->arg("alpha"))->value();
+        int rank
+          = dynamic_cast<stan::services::int_argument*>
+          (metric->arg("rank"))->value();
+        double tol
+          = dynamic_cast<stan::services::real_argument*>
+          (metric->arg("tol"))->value();
+        int max_resolvent
+          = dynamic_cast<stan::services::int_argument*>
+          (metric->arg("max_resolvent"))->value();
+
+        Sampler* s = dynamic_cast<Sampler*>(sampler);
+        s->z().alpha = alpha;
+        s->z().rank = rank;
+        s->z().tol = tol;
+        s->z().max_num_resolvent = max_resolvent;
+
+        return true;
+      }
+
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef STAN_SERVICES_SAMPLE_INIT_METRIC_HPP
+#define STAN_SERVICES_SAMPLE_INIT_METRIC_HPP
+
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
+#include <stan/mcmc/hmc/hamiltonians/block_dense_e_point.hpp>
+#include <stan/mcmc/hmc/hamiltonians/lowrank_diag_e_point.hpp>
+#include <stan/mcmc/hmc/hamiltonians/lowrank_softabs_point.hpp>
+#include <stan/mcmc/hmc/hamiltonians/softabs_point.hpp>
+#include <stan/services/arguments/argument.hpp>
+#include <stan/services/sample/init_block_dense_e.hpp>
+#include <stan/services/sample/init_lowrank_diag_e.hpp>
+#include <stan/services/sample/init_lowrank_softabs.hpp>
+#include <stan/services/sample/init_softabs.hpp>
+
+namespace stan {
+  namespace services {
+    namespace sample {
+
+      // Metrics without options
+      template<class Sampler, class Model>
+      bool init_metric_(stan::mcmc::base_mcmc* sampler,
+                        stan::services::argument* algorithm,
+                        const Model& model,
+                        stan::mcmc::ps_point& z) {
+        return true;
+      }
+
+      template<class Sampler, class Model>
+      bool init_metric_(stan::mcmc::base_mcmc* sampler,
+                        stan::services::argument* algorithm,
+                        const Model& model,
+                        stan::mcmc::lowrank_diag_e_point& z) {
+        return init_lowrank_diag_e<Sampler>(sampler, algorithm);
+      }
+
+      template<class Sampler, class Model>
+      bool init_metric_(stan::mcmc::base_mcmc* sampler,
+                        stan::services::argument* algorithm,
+                        const Model& model,
+                        stan::mcmc::block_dense_e_point& z) {
+        return init_block_dense_e<Sampler>(sampler, algorithm, model);
+      }
+
+      template<class Sampler, class Model>
+      bool init_metric_(stan::mcmc::base_mcmc* sampler,
+                        stan::services::argument* algorithm,
+                        const Model& model,
+                        stan::mcmc::softabs_point& z) {
+        return init_softabs<Sampler>(sampler, algorithm);
+      }
+
+      template<class Sampler, class Model>
+      bool init_metric_(stan::mcmc::base_mcmc* sampler,
+                        stan::services::argument* algorithm,
+                        const Model& model,
+                        stan::mcmc::lowrank_softabs_point& z) {
+        return init_lowrank_softabs<Sampler>(sampler, algorithm);
+      }
+
+      /**
+       * Applies the options of the metric selected by the hmc metric
+       * argument to a sampler built for that metric.  The options are
+       * picked by the point type of the sampler, so this compiles for
+       * every HMC sampler; interfaces call it with init_nuts,
+       * init_static_hmc or init_xhmc once the sampler is constructed.
+       *
+       * @return false if the metric of the sampler has options and
+       *   the metric argument selects another metric
+       */
+      template<class Sampler, class Model>
+      bool init_metric(stan::mcmc::base_mcmc* sampler,
+                       stan::services::argument* algorithm,
+                       const Model& model) {
+        return init_metric_<Sampler>(sampler, algorithm, model,
+                                     dynamic_cast<Sampler*>(sampler)->z());
+      }
+
+    }
+  }
+}
+
+#endif
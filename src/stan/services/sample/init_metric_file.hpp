@@ -0,0 +1,62 @@
+#ifndef STAN_SERVICES_SAMPLE_INIT_METRIC_FILE_HPP
+#define STAN_SERVICES_SAMPLE_INIT_METRIC_FILE_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/io/dump.hpp>
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/services/arguments/argument.hpp>
+#include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/singleton_argument.hpp>
+#include <stan/services/sample/load_adapted_params.hpp>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace stan {
+  namespace services {
+    namespace sample {
+
+      /**
+       * Starts a sampler from the step size and inverse metric in the
+       * file named by the hmc metric_file argument, if any, with
+       * load_adapted_params.  Call it before init_adapt, as for
+       * load_adapted_params.
+       *
+       * @return false if the file cannot be read or its values do not
+       *   fit the sampler
+       */
+      template <class Sampler>
+      bool init_metric_file(stan::mcmc::base_mcmc* sampler,
+                            stan::services::argument* algorithm,
+                            interface_callbacks::writer::base_writer&
+                            error_writer) {
+        stan::services::categorical_argument* hmc
+          = dynamic_cast<stan::services::categorical_argument*>
+          (algorithm->arg("hmc"));
+
+        std::string path
+          = dynamic_cast<stan::services::string_argument*>
+          (hmc->arg("metric_file"))->value();
+        if (path.empty())
+          return true;
+
+        std::ifstream stream(path.c_str());
+        if (!stream) {
+          error_writer("Cannot open metric_file " + path + ".");
+          return false;
+        }
+
+        try {
+          stan::io::dump context(stream);
+          return load_adapted_params<Sampler>(sampler, context, error_writer);
+        } catch (const std::exception& e) {
+          error_writer(e.what());
+          return false;
+        }
+      }
+
+    }
+  }
+}
+
+#endif
@@ -10,18 +10,26 @@ namespace stan {
   namespace services {
     namespace sample {
 
+      /**
+       * Sets the regularization of a SoftAbs sampler.  Returns false
+       * unless the metric argument selects softabs.
+       */
       template<class Sampler>
       bool init_softabs(stan::mcmc::base_mcmc* sampler,
                         stan::services::argument* algorithm) {
         stan::services::categorical_argument* hmc
           = dynamic_cast<stan::services::categorical_argument*>
           (algorithm->arg("hmc"));
+        stan::services::argument* metric
+          = hmc->arg("metric")->arg("softabs");
+        if (!metric)
+          return false;
 
         double alpha
           = dynamic_cast<stan::services::real_argument*>
-          (hmc->arg("metric")->arg("softabs")->arg("alpha"))->value();
+          (metric->arg("alpha"))->value();
 
-        dynamic_cast<Sampler*>(sampler)->z()->set_alpha(alpha);
+        dynamic_cast<Sampler*>(sampler)->z().alpha = alpha;
 
         return true;
       }
@@ -0,0 +1,35 @@
+#ifndef STAN_SERVICES_SAMPLE_INIT_WARMUP_CONTROLLER_HPP
+#define STAN_SERVICES_SAMPLE_INIT_WARMUP_CONTROLLER_HPP
+
+#include <stan/mcmc/warmup_controller.hpp>
+#include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/singleton_argument.hpp>
+
+namespace stan {
+  namespace services {
+    namespace sample {
+
+      /**
+       * Configures early termination of warmup from the adapt
+       * arguments.
+       *
+       * @return false if early termination is off, in which case the
+       *   controller should not be passed to warmup
+       */
+      inline bool
+      init_warmup_controller(stan::mcmc::warmup_controller& controller,
+                             categorical_argument* adapt) {
+        bool early_stop
+          = dynamic_cast<bool_argument*>(adapt->arg("early_stop"))->value();
+        unsigned int min_warmup
+          = dynamic_cast<u_int_argument*>(adapt->arg("min_warmup"))->value();
+
+        controller.set_min_warmup(min_warmup);
+        return early_stop;
+      }
+
+    }
+  }
+}
+
+#endif
@@ -3,9 +3,13 @@
 
 #include <stan/interface_callbacks/writer/base_writer.hpp>
 #include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/stepsize_covar_adapter.hpp>
+#include <stan/mcmc/warmup_controller.hpp>
 #include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/singleton_argument.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/services/sample/init_adapt.hpp>
+#include <stan/services/sample/init_warmup_controller.hpp>
 #include <ostream>
 
 namespace stan {
@@ -34,6 +38,39 @@ namespace stan {
           ->set_window_params(num_warmup, init_buffer, term_buffer,
                               window, info_writer);
 
+        // Only the dense metric keeps a factor to stream
+        stan::mcmc::stepsize_covar_adapter* covar_adapter
+          = dynamic_cast<stan::mcmc::stepsize_covar_adapter*>(sampler);
+        if (covar_adapter) {
+          bool streaming
+            = dynamic_cast<bool_argument*>(adapt->arg("streaming"))->value();
+          covar_adapter->get_covar_adaptation().set_streaming(streaming);
+        }
+
+        return true;
+      }
+
+      /**
+       * Configures windowed adaptation as above, and early
+       * termination of warmup through a controller constructed on
+       * the adaptations of the sampler.
+       *
+       * @param[out] early_stop Whether the controller should be
+       *   passed to warmup
+       */
+      template<class Sampler>
+      bool
+      init_windowed_adapt(stan::mcmc::base_mcmc* sampler,
+                          stan::services::categorical_argument* adapt,
+                          unsigned int num_warmup,
+                          const Eigen::VectorXd& cont_params,
+                          stan::mcmc::warmup_controller& controller,
+                          bool& early_stop,
+                          interface_callbacks::writer::base_writer& info_writer,
+                      interface_callbacks::writer::base_writer& error_writer) {
+        init_windowed_adapt<Sampler>(sampler, adapt, num_warmup, cont_params,
+                                     info_writer, error_writer);
+        early_stop = init_warmup_controller(controller, adapt);
         return true;
       }
 
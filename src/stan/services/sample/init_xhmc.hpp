@@ -2,9 +2,12 @@
 #define STAN_SERVICES_SAMPLE_INIT_XHMC_HPP
 
 #include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/hmc/integrators/integrator_scheme.hpp>
 #include <stan/services/arguments/argument.hpp>
 #include <stan/services/arguments/categorical_argument.hpp>
+#include <stan/services/arguments/list_argument.hpp>
 #include <stan/services/arguments/singleton_argument.hpp>
+#include <string>
 
 namespace stan {
   namespace services {
@@ -26,6 +29,15 @@ namespace stan {
         double epsilon_jitter
           = dynamic_cast<stan::services::real_argument*>
             (hmc->arg("stepsize_jitter"))->value();
+        std::string integrator
+          = dynamic_cast<stan::services::list_argument*>
+            (hmc->arg("integrator"))->value();
+        int stride
+          = dynamic_cast<stan::services::int_argument*>
+            (hmc->arg("stepsize_stride"))->value();
+        double threshold_scale
+          = dynamic_cast<stan::services::real_argument*>
+            (hmc->arg("adaptive_threshold"))->value();
         int max_depth
           = dynamic_cast<stan::services::int_argument*>
             (base->arg("max_depth"))->value();
@@ -35,6 +47,11 @@ namespace stan {
 
         dynamic_cast<Sampler*>(sampler)->set_nominal_stepsize(epsilon);
         dynamic_cast<Sampler*>(sampler)->set_stepsize_jitter(epsilon_jitter);
+        dynamic_cast<Sampler*>(sampler)->set_init_stepsize_stride(stride);
+        dynamic_cast<Sampler*>(sampler)->set_integrator_scheme(
+          stan::mcmc::integrator_scheme_from_name(integrator));
+        dynamic_cast<Sampler*>(sampler)
+          ->set_adaptive_threshold_scale(threshold_scale);
         dynamic_cast<Sampler*>(sampler)->set_max_depth(max_depth);
         dynamic_cast<Sampler*>(sampler)->set_x_delta(x_delta);
 
@@ -0,0 +1,117 @@
+#ifndef STAN_SERVICES_SAMPLE_LOAD_ADAPTED_PARAMS_HPP
+#define STAN_SERVICES_SAMPLE_LOAD_ADAPTED_PARAMS_HPP
+
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/io/var_context.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/hmc/hamiltonians/dense_e_point.hpp>
+#include <stan/mcmc/hmc/hamiltonians/diag_e_point.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <Eigen/Cholesky>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace services {
+    namespace sample {
+
+      /**
+       * Sets a diagonal inverse metric from the values of a vector.
+       *
+       * @return false if the values are not a vector of positive
+       *   finite values of the size of the point
+       */
+      inline bool set_inv_metric(stan::mcmc::diag_e_point& z,
+                                 const std::vector<double>& values,
+                                 const std::vector<size_t>& dims) {
+        int n = z.q.size();
+        if (dims.size() != 1 || dims[0] != static_cast<size_t>(n))
+          return false;
+        for (int i = 0; i < n; ++i)
+          if (!(values[i] > 0) || !boost::math::isfinite(values[i]))
+            return false;
+
+        z.mInv = Eigen::Map<const Eigen::VectorXd>(&values[0], n);
+        return true;
+      }
+
+      /**
+       * Sets a dense inverse metric from the column-major values of
+       * a matrix.
+       *
+       * @return false if the values are not a symmetric positive
+       *   definite matrix of the size of the point
+       */
+      inline bool set_inv_metric(stan::mcmc::dense_e_point& z,
+                                 const std::vector<double>& values,
+                                 const std::vector<size_t>& dims) {
+        int n = z.q.size();
+        if (dims.size() != 2 || dims[0] != static_cast<size_t>(n)
+            || dims[1] != static_cast<size_t>(n))
+          return false;
+
+        Eigen::MatrixXd mInv
+          = Eigen::Map<const Eigen::MatrixXd>(&values[0], n, n);
+        if (!mInv.allFinite()
+            || !mInv.isApprox(mInv.transpose(), 1e-8)
+            || mInv.llt().info() != Eigen::Success)
+          return false;
+
+        z.mInv = 0.5 * (mInv + mInv.transpose());
+        z.update_mInv_factor();
+        return true;
+      }
+
+      /**
+       * Starts a sampler with a diagonal or dense metric from the
+       * variables stepsize and inverse metric inv_metric adapted by
+       * an earlier run, as written by mcmc_writer::write_adapted_params.
+       * Either variable may be absent.
+       *
+       * Load before init_adapt, so the step size adaptation starts
+       * from the loaded step size.  Warmup can then be skipped, or
+       * shortened with an adaptation window of 0, which only adapts
+       * the step size and keeps the loaded metric.
+       *
+       * @param sampler Sampler
+       * @param context Variables of the earlier run
+       * @param error_writer Writer for errors
+       * @return false if the values do not fit the sampler
+       */
+      template <class Sampler>
+      bool load_adapted_params(stan::mcmc::base_mcmc* sampler,
+                               const stan::io::var_context& context,
+                               interface_callbacks::writer::base_writer&
+                               error_writer) {
+        Sampler* hmc = dynamic_cast<Sampler*>(sampler);
+
+        if (context.contains_r("stepsize")) {
+          std::vector<double> stepsize = context.vals_r("stepsize");
+          if (stepsize.size() != 1 || !(stepsize[0] > 0)
+              || !boost::math::isfinite(stepsize[0])) {
+            error_writer("The loaded stepsize must be a positive "
+                         "finite scalar.");
+            return false;
+          }
+          hmc->set_nominal_stepsize(stepsize[0]);
+        }
+
+        if (context.contains_r("inv_metric")
+            && !set_inv_metric(hmc->z(), context.vals_r("inv_metric"),
+                               context.dims_r("inv_metric"))) {
+          error_writer("The loaded inv_metric does not fit the metric of "
+                       "the sampler, or is not positive definite.");
+          return false;
+        }
+
+        hmc->z().invalidate_kinetic();
+        return true;
+      }
+
+    }
+  }
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <stan/mcmc/base_mcmc.hpp>
 #include <stan/mcmc/sample.hpp>
+#include <stan/mcmc/transition_profile.hpp>
 #include <stan/model/prob_grad.hpp>
 #include <sstream>
 #include <iomanip>
@@ -93,12 +94,16 @@ namespace stan {
          * @param sample the sample in constrained space
          * @param sampler the sampler
          * @param model the model
+         * @param profile profile timing model.write_array(), if any
          */
         template <class RNG>
         void write_sample_params(RNG& rng,
                                  stan::mcmc::sample& sample,
                                  stan::mcmc::base_mcmc& sampler,
-                                 Model& model) {
+                                 Model& model,
+                                 stan::mcmc::transition_profile* profile
+                                 = 0) {
+          typedef stan::mcmc::transition_profile profile_t;
           std::vector<double> values;
 
           sample.get_sample_params(values);
@@ -107,11 +112,13 @@ namespace stan {
           Eigen::VectorXd model_values;
 
           std::stringstream ss;
+          if (profile) profile->begin(profile_t::write_array_phase);
           model.write_array(rng,
                             const_cast<Eigen::VectorXd&>(sample.cont_params()),
                             model_values,
                             true, true,
                             &ss);
+          if (profile) profile->end(profile_t::write_array_phase);
           if (ss.str().length() > 0)
             message_writer_(ss.str());
 
@@ -133,6 +140,22 @@ namespace stan {
           sampler->write_sampler_state(sample_writer_);
         }
 
+        /**
+         * Writes the adapted step size and inverse metric as the
+         * key-value pairs stepsize and inv_metric.  Written with a
+         * dump_writer, they can be read back with stan::io::dump
+         * and loaded by load_adapted_params to start a later run.
+         *
+         * @param sampler sampler
+         * @param writer writer receiving the adapted parameters
+         */
+        void
+        write_adapted_params(stan::mcmc::base_mcmc* sampler,
+                             interface_callbacks::writer::base_writer&
+                             writer) {
+          sampler->write_adapted_params(writer);
+        }
+
 
         /**
          * Print diagnostic names
@@ -434,37 +434,67 @@ namespace stan {
         Eigen::VectorXd eta = Eigen::VectorXd::Zero(dimension_);
         Eigen::VectorXd zeta = Eigen::VectorXd::Zero(dimension_);
 
-        // Naive Monte Carlo integration
+        // Naive Monte Carlo integration, evaluating the gradients of
+        // the draws still needed in one batch
         static const int n_retries = 10;
+        Eigen::MatrixXd eta_batch;
+        Eigen::MatrixXd zeta_batch;
+        Eigen::VectorXd lp_batch;
+        Eigen::MatrixXd grad_batch;
         for (int i = 0, n_monte_carlo_drop = 0; i < n_monte_carlo_grad; ) {
           // Draw from standard normal and transform to real-coordinate space
-          for (int d = 0; d < dimension_; ++d) {
-            eta(d) = stan::math::normal_rng(0, 1, rng);
+          const int n_batch = n_monte_carlo_grad - i;
+          eta_batch.resize(dimension_, n_batch);
+          zeta_batch.resize(dimension_, n_batch);
+          for (int k = 0; k < n_batch; ++k) {
+            for (int d = 0; d < dimension_; ++d)
+              eta_batch(d, k) = stan::math::normal_rng(0, 1, rng);
+            zeta_batch.col(k) = transform(eta_batch.col(k));
           }
-          zeta = transform(eta);
+
+          // A batch that throws is evaluated draw by draw, so that
+          // only the failing draws are dropped
+          bool batch_valid = true;
           try {
             std::stringstream ss;
-            stan::model::gradient(m, zeta, tmp_lp, tmp_mu_grad, &ss);
+            stan::model::gradients(m, zeta_batch, lp_batch, grad_batch, &ss);
             if (ss.str().length() > 0)
               message_writer(ss.str());
-            stan::math::check_finite(function, "Gradient of mu", tmp_mu_grad);
+          } catch (const std::exception& e) {
+            batch_valid = false;
+          }
 
-            mu_grad += tmp_mu_grad;
-            for (int ii = 0; ii < dimension_; ++ii) {
-              for (int jj = 0; jj <= ii; ++jj) {
-                L_grad(ii, jj) += tmp_mu_grad(ii) * eta(jj);
+          for (int k = 0; k < n_batch; ++k) {
+            eta = eta_batch.col(k);
+            try {
+              if (batch_valid) {
+                tmp_mu_grad = grad_batch.col(k);
+              } else {
+                zeta = zeta_batch.col(k);
+                std::stringstream ss;
+                stan::model::gradient(m, zeta, tmp_lp, tmp_mu_grad, &ss);
+                if (ss.str().length() > 0)
+                  message_writer(ss.str());
+              }
+              stan::math::check_finite(function, "Gradient of mu", tmp_mu_grad);
+
+              mu_grad += tmp_mu_grad;
+              for (int ii = 0; ii < dimension_; ++ii) {
+                for (int jj = 0; jj <= ii; ++jj) {
+                  L_grad(ii, jj) += tmp_mu_grad(ii) * eta(jj);
+                }
+              }
+              ++i;
+            } catch (const std::exception& e) {
+              ++n_monte_carlo_drop;
+              if (n_monte_carlo_drop >= n_retries * n_monte_carlo_grad) {
+                const char* name = "The number of dropped evaluations";
+                const char* msg1 = "has reached its maximum amount (";
+                int y = n_retries * n_monte_carlo_grad;
+                const char* msg2 = "). Your model may be either severely "
+                  "ill-conditioned or misspecified.";
+                stan::math::domain_error(function, name, y, msg1, msg2);
               }
-            }
-            ++i;
-          } catch (const std::exception& e) {
-            ++n_monte_carlo_drop;
-            if (n_monte_carlo_drop >= n_retries * n_monte_carlo_grad) {
-              const char* name = "The number of dropped evaluations";
-              const char* msg1 = "has reached its maximum amount (";
-              int y = n_retries * n_monte_carlo_grad;
-              const char* msg2 = "). Your model may be either severely "
-                "ill-conditioned or misspecified.";
-              stan::math::domain_error(function, name, y, msg1, msg2);
             }
           }
         }
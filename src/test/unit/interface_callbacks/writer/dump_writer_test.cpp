@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <stan/interface_callbacks/writer/dump_writer.hpp>
+#include <stan/io/dump.hpp>
+#include <sstream>
+#include <vector>
+
+class StanInterfaceCallbacksDumpWriter: public ::testing::Test {
+public:
+  StanInterfaceCallbacksDumpWriter() :
+    ss(), writer(ss) {}
+
+  void SetUp() {
+    ss.str(std::string());
+    ss.clear();
+  }
+  void TearDown() { }
+
+  std::stringstream ss;
+  stan::interface_callbacks::writer::dump_writer writer;
+};
+
+TEST_F(StanInterfaceCallbacksDumpWriter, key_double) {
+  EXPECT_NO_THROW(writer("key", 5.2));
+  EXPECT_EQ("key <- 5.2000000000000002\n", ss.str());
+}
+
+TEST_F(StanInterfaceCallbacksDumpWriter, key_int) {
+  EXPECT_NO_THROW(writer("key", 5));
+  EXPECT_EQ("key <- 5\n", ss.str());
+}
+
+TEST_F(StanInterfaceCallbacksDumpWriter, key_vector) {
+  const double x[] = {1, 0.5, -2};
+  EXPECT_NO_THROW(writer("key", x, 3));
+  EXPECT_EQ("key <- c(1, 0.5, -2)\n", ss.str());
+}
+
+TEST_F(StanInterfaceCallbacksDumpWriter, key_matrix) {
+  // Row-major 2 x 3 matrix, written in column-major order
+  const double x[] = {1, 2, 3, 4, 5, 6};
+  EXPECT_NO_THROW(writer("key", x, 2, 3));
+  EXPECT_EQ("key <- structure(c(1, 4, 2, 5, 3, 6), .Dim = c(2, 3))\n",
+            ss.str());
+}
+
+TEST_F(StanInterfaceCallbacksDumpWriter, ignored) {
+  EXPECT_NO_THROW(writer("key", "value"));
+  EXPECT_NO_THROW(writer(std::vector<std::string>(1, "name")));
+  EXPECT_NO_THROW(writer(std::vector<double>(1, 1.0)));
+  EXPECT_NO_THROW(writer());
+  EXPECT_NO_THROW(writer("message"));
+  EXPECT_EQ("", ss.str());
+}
+
+TEST_F(StanInterfaceCallbacksDumpWriter, round_trip) {
+  const double x[] = {1.0 / 3.0, 0.1, 2, 1e-5};
+  writer("stepsize", 0.1);
+  writer("inv_metric", x, 2, 2);
+
+  stan::io::dump dump(ss);
+  ASSERT_TRUE(dump.contains_r("stepsize"));
+  EXPECT_EQ(0.1, dump.vals_r("stepsize")[0]);
+
+  std::vector<size_t> dims = dump.dims_r("inv_metric");
+  std::vector<double> vals = dump.vals_r("inv_metric");
+  ASSERT_EQ(2U, dims.size());
+  EXPECT_EQ(2U, dims[0]);
+  EXPECT_EQ(2U, dims[1]);
+  EXPECT_EQ(x[0], vals[0]);
+  EXPECT_EQ(x[2], vals[1]);
+  EXPECT_EQ(x[1], vals[2]);
+  EXPECT_EQ(x[3], vals[3]);
+}
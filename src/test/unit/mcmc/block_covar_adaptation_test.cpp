@@ -0,0 +1,52 @@
+#include <stan/mcmc/block_covar_adaptation.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(McmcBlockCovarAdaptation, learn_covariance) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  const int n = 5;
+  const int n_learn = 10;
+
+  std::vector<int> sizes;
+  sizes.push_back(2);
+  sizes.push_back(3);
+
+  stan::mcmc::block_covar_adaptation adapter(n);
+  adapter.set_blocks(sizes);
+  adapter.set_window_params(50, 0, 0, n_learn, writer);
+
+  // The two coordinates of the first block move together
+  std::vector<Eigen::MatrixXd> covar;
+  bool update = false;
+  for (int i = 0; i < n_learn; ++i) {
+    Eigen::VectorXd q = Eigen::VectorXd::Zero(n);
+    q(0) = i;
+    q(1) = i;
+    update = adapter.learn_covariance(covar, q);
+  }
+
+  ASSERT_TRUE(update);
+  ASSERT_EQ(2U, covar.size());
+  ASSERT_EQ(2, covar[0].rows());
+  ASSERT_EQ(3, covar[1].rows());
+
+  double w = n_learn / (n_learn + 5.0);
+  double reg = 1e-3 * 5.0 / (n_learn + 5.0);
+  double var = 0;
+  for (int i = 0; i < n_learn; ++i)
+    var += (i - 4.5) * (i - 4.5);
+  var /= n_learn - 1.0;
+
+  EXPECT_FLOAT_EQ(w * var + reg, covar[0](0, 0));
+  EXPECT_FLOAT_EQ(w * var, covar[0](0, 1));
+  EXPECT_FLOAT_EQ(w * var + reg, covar[0](1, 1));
+
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_FLOAT_EQ(i == j ? reg : 0, covar[1](i, j));
+
+  EXPECT_EQ("", ss.str());
+}
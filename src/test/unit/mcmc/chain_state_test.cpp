@@ -0,0 +1,71 @@
+#include <stan/mcmc/chain_state.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
+
+TEST(McmcChainState, round_trip) {
+  std::stringstream ss;
+
+  Eigen::VectorXd v(3);
+  v << 1.0 / 3.0, -2e-300, std::numeric_limits<double>::infinity();
+  Eigen::MatrixXd m(2, 3);
+  m << 0.1, 0.2, 0.3, 0.4, 0.5, std::exp(1.0);
+
+  stan::mcmc::write_chain_state(ss, 0.1);
+  stan::mcmc::write_chain_state(ss, v);
+  stan::mcmc::write_chain_state(ss, m);
+
+  double x;
+  Eigen::VectorXd v_read;
+  Eigen::MatrixXd m_read;
+  stan::mcmc::read_chain_state(ss, x);
+  stan::mcmc::read_chain_state(ss, v_read, 3);
+  stan::mcmc::read_chain_state(ss, m_read);
+
+  EXPECT_EQ(0.1, x);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(v(i), v_read(i));
+  ASSERT_EQ(2, m_read.rows());
+  ASSERT_EQ(3, m_read.cols());
+  for (int i = 0; i < m.size(); ++i)
+    EXPECT_EQ(m(i), m_read(i));
+
+  EXPECT_THROW(stan::mcmc::read_chain_state(ss, x), std::domain_error);
+}
+
+TEST(McmcChainState, size_mismatch) {
+  std::stringstream ss;
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(2);
+  stan::mcmc::write_chain_state(ss, x);
+
+  Eigen::VectorXd v;
+  EXPECT_THROW(stan::mcmc::read_chain_state(ss, v, 3), std::domain_error);
+}
+
+TEST(McmcChainState, restorable_var_estimator) {
+  stan::mcmc::restorable_var_estimator estimator(2);
+  stan::mcmc::restorable_var_estimator restored(2);
+
+  Eigen::VectorXd q(2);
+  for (int i = 0; i < 5; ++i) {
+    q << 0.3 * i, 1.0 / (i + 1);
+    estimator.add_sample(q);
+  }
+
+  std::stringstream ss;
+  estimator.write_state(ss);
+  restored.read_state(ss);
+
+  q << -1, 2;
+  estimator.add_sample(q);
+  restored.add_sample(q);
+
+  Eigen::VectorXd var_1(2);
+  Eigen::VectorXd var_2(2);
+  estimator.sample_variance(var_1);
+  restored.sample_variance(var_2);
+
+  EXPECT_EQ(estimator.num_samples(), restored.num_samples());
+  EXPECT_EQ(var_1(0), var_2(0));
+  EXPECT_EQ(var_1(1), var_2(1));
+}
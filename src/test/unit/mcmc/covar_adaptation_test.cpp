@@ -28,3 +28,82 @@ TEST(McmcCovarAdaptation, learn_covariance) {
   }
   EXPECT_EQ("", ss.str());
 }
+
+TEST(McmcCovarAdaptation, learn_covariance_pooled) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  const int n = 2;
+  const int n_learn = 10;
+
+  stan::mcmc::covar_adaptation adapter_1(n);
+  stan::mcmc::covar_adaptation adapter_2(n);
+  adapter_1.set_window_params(50, 0, 0, n_learn, writer);
+  adapter_2.set_window_params(50, 0, 0, n_learn, writer);
+
+  std::vector<stan::mcmc::covar_adaptation*> pool;
+  pool.push_back(&adapter_1);
+  pool.push_back(&adapter_2);
+  adapter_1.set_pool(pool);
+  adapter_2.set_pool(pool);
+
+  Eigen::MatrixXd covar_1(Eigen::MatrixXd::Zero(n, n));
+  Eigen::MatrixXd covar_2(Eigen::MatrixXd::Zero(n, n));
+
+  // Each chain alone has zero variance; only pooling sees the spread
+  Eigen::VectorXd q_1 = Eigen::VectorXd::Ones(n);
+  Eigen::VectorXd q_2 = -Eigen::VectorXd::Ones(n);
+  for (int i = 0; i < n_learn; ++i) {
+    adapter_1.learn_covariance(covar_1, q_1);
+    adapter_2.learn_covariance(covar_2, q_2);
+  }
+
+  double n_draws = 2 * (n_learn - 1);
+  double target_covar = (n_draws / (n_draws + 5.0)) * n_draws / (n_draws - 1);
+
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double target = target_covar + (i == j ? 1e-3 * 5.0 / (n_draws + 5.0) : 0);
+      EXPECT_FLOAT_EQ(target, covar_1(i, j));
+      EXPECT_EQ(covar_1(i, j), covar_2(i, j));
+    }
+  }
+  EXPECT_EQ("", ss.str());
+}
+
+TEST(McmcCovarAdaptation, learn_covariance_streaming) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  const int n = 4;
+  const int n_learn = 20;
+
+  stan::mcmc::covar_adaptation batch(n);
+  stan::mcmc::covar_adaptation streaming(n);
+  batch.set_window_params(100, 0, 0, n_learn, writer);
+  streaming.set_window_params(100, 0, 0, n_learn, writer);
+  streaming.set_streaming(true);
+
+  Eigen::MatrixXd covar_1(Eigen::MatrixXd::Zero(n, n));
+  Eigen::MatrixXd covar_L_1(Eigen::MatrixXd::Zero(n, n));
+  Eigen::MatrixXd covar_2(Eigen::MatrixXd::Zero(n, n));
+  Eigen::MatrixXd covar_L_2(Eigen::MatrixXd::Zero(n, n));
+
+  Eigen::VectorXd q(n);
+  for (int i = 0; i < n_learn; ++i) {
+    for (int d = 0; d < n; ++d)
+      q(d) = std::sin(1.3 * i + 0.7 * d * d) + 0.1 * d * i;
+    batch.learn_covariance(covar_1, covar_L_1, q);
+    streaming.learn_covariance(covar_2, covar_L_2, q);
+  }
+
+  Eigen::MatrixXd covar_LLT = covar_L_2 * covar_L_2.transpose();
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      EXPECT_FLOAT_EQ(covar_1(i, j), covar_2(i, j));
+      EXPECT_NEAR(covar_L_1(i, j), covar_L_2(i, j), 1e-8);
+      EXPECT_NEAR(covar_2(i, j), covar_LLT(i, j), 1e-8);
+    }
+  }
+  EXPECT_EQ("", ss.str());
+}
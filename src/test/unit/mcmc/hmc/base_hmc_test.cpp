@@ -34,6 +34,55 @@ namespace stan {
       void get_sampler_params(std::vector<double>& values) {}
     };
 
+    // Moves along the fixed momentum to a quadratic potential, so a
+    // step from the origin is accepted with probability
+    // exp(-epsilon^2 |p|^2 / 2)
+    template <typename Hamiltonian>
+    class quadratic_integrator: public base_integrator<Hamiltonian> {
+
+    public:
+      quadratic_integrator()
+        : base_integrator<Hamiltonian>(), num_evolve(0) { }
+
+      void evolve(typename Hamiltonian::PointType& z,
+                  Hamiltonian& hamiltonian,
+                  const double epsilon,
+                  interface_callbacks::writer::base_writer& info_writer,
+                  interface_callbacks::writer::base_writer& error_writer) {
+        z.q += epsilon * z.p;
+        z.V = 0.5 * z.q.squaredNorm();
+        ++num_evolve;
+      }
+
+      int num_evolve;
+    };
+
+    class quadratic_hmc: public base_hmc<mock_model,
+                                         mock_hamiltonian,
+                                         quadratic_integrator,
+                                         rng_t> {
+
+    public:
+      quadratic_hmc(const mock_model& m, rng_t& rng)
+        : base_hmc<mock_model, mock_hamiltonian,
+                   quadratic_integrator, rng_t>(m, rng)
+      { }
+
+      sample transition(sample& init_sample,
+                        interface_callbacks::writer::base_writer& info_writer,
+                        interface_callbacks::writer::base_writer& error_writer) {
+        return init_sample;
+      }
+
+      void get_sampler_param_names(std::vector<std::string>& names) {}
+
+      void get_sampler_params(std::vector<double>& values) {}
+
+      int num_evolve() {
+        return this->integrator_.num_evolve;
+      }
+    };
+
   }
 
 }
@@ -131,3 +180,106 @@ TEST(McmcBaseHMC, streams) {
   EXPECT_EQ("", stan::test::cout_ss.str());
   EXPECT_EQ("", stan::test::cerr_ss.str());
 }
+
+TEST(McmcBaseHMC, set_init_stepsize_stride) {
+  rng_t base_rng(0);
+
+  stan::mcmc::mock_model model(1);
+  stan::mcmc::quadratic_hmc sampler(model, base_rng);
+
+  EXPECT_EQ(1, sampler.get_init_stepsize_stride());
+
+  sampler.set_init_stepsize_stride(4);
+  EXPECT_EQ(4, sampler.get_init_stepsize_stride());
+
+  sampler.set_init_stepsize_stride(0);
+  EXPECT_EQ(4, sampler.get_init_stepsize_stride());
+}
+
+TEST(McmcBaseHMC, init_stepsize_stride_matches_doubling) {
+  rng_t base_rng(0);
+  std::stringstream output;
+  stan::interface_callbacks::writer::stream_writer writer(output);
+
+  stan::mcmc::mock_model model(1);
+
+  // Accepted with probability above 0.8 up to a step size of 0.668
+  double expected = 1e-6 * std::pow(2.0, 20);
+
+  int num_evolve[2];
+  int strides[2] = {1, 4};
+  for (int i = 0; i < 2; ++i) {
+    stan::mcmc::quadratic_hmc sampler(model, base_rng);
+    sampler.z().q.setZero();
+    sampler.z().p.setOnes();
+    sampler.set_init_stepsize_stride(strides[i]);
+    sampler.set_nominal_stepsize(1e-6);
+
+    sampler.init_stepsize(writer, writer);
+
+    EXPECT_EQ(expected, sampler.get_nominal_stepsize());
+    EXPECT_EQ(0, sampler.z().q(0));
+    num_evolve[i] = sampler.num_evolve();
+  }
+
+  EXPECT_EQ(22, num_evolve[0]);
+  EXPECT_EQ(9, num_evolve[1]);
+  EXPECT_EQ("", output.str());
+}
+
+TEST(McmcBaseHMC, init_stepsize_stride_shrinks) {
+  rng_t base_rng(0);
+  std::stringstream output;
+  stan::interface_callbacks::writer::stream_writer writer(output);
+
+  stan::mcmc::mock_model model(1);
+
+  for (int stride = 1; stride <= 5; ++stride) {
+    stan::mcmc::quadratic_hmc sampler(model, base_rng);
+    sampler.z().q.setZero();
+    sampler.z().p.setOnes();
+    sampler.set_init_stepsize_stride(stride);
+    sampler.set_nominal_stepsize(1000);
+
+    sampler.init_stepsize(writer, writer);
+
+    EXPECT_EQ(1000 * std::pow(2.0, -11), sampler.get_nominal_stepsize())
+      << "stride " << stride;
+  }
+}
+
+TEST(McmcBaseHMC, init_stepsize_stride_clamped) {
+  rng_t base_rng(0);
+  std::stringstream output;
+  stan::interface_callbacks::writer::stream_writer writer(output);
+
+  stan::mcmc::mock_model model(1);
+
+  // Accepted with probability above 0.8 up to a step size of
+  // 6.68e6, so large strides step past 1e7 before the criterion
+  // flips
+  for (int stride = 1; stride <= 8; ++stride) {
+    stan::mcmc::quadratic_hmc sampler(model, base_rng);
+    sampler.z().q.setZero();
+    sampler.z().p.setConstant(1e-7);
+    sampler.set_init_stepsize_stride(stride);
+    sampler.set_nominal_stepsize(1);
+
+    sampler.init_stepsize(writer, writer);
+
+    EXPECT_EQ(std::pow(2.0, 23), sampler.get_nominal_stepsize())
+      << "stride " << stride;
+  }
+
+  // Without a flip below 1e7 every stride fails, as doubling does
+  for (int stride = 1; stride <= 8; ++stride) {
+    stan::mcmc::quadratic_hmc sampler(model, base_rng);
+    sampler.z().q.setZero();
+    sampler.z().p.setZero();
+    sampler.set_init_stepsize_stride(stride);
+    sampler.set_nominal_stepsize(1);
+
+    EXPECT_THROW(sampler.init_stepsize(writer, writer), std::runtime_error)
+      << "stride " << stride;
+  }
+}
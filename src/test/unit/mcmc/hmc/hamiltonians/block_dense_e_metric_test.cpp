@@ -0,0 +1,99 @@
+#include <stan/mcmc/hmc/hamiltonians/block_dense_e_metric.hpp>
+#include <test/unit/mcmc/hmc/mock_hmc.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+typedef boost::ecuyer1988 rng_t;
+
+namespace {
+  // Blocks of sizes 2, 1 and 2 with correlated entries
+  void set_test_blocks(stan::mcmc::block_dense_e_point& z) {
+    std::vector<int> sizes;
+    sizes.push_back(2);
+    sizes.push_back(1);
+    sizes.push_back(2);
+    z.set_blocks(sizes);
+
+    z.mInv[0] << 2, 0.5,
+                 0.5, 1;
+    z.mInv[1] << 3;
+    z.mInv[2] << 0.25, -0.1,
+                 -0.1, 4;
+    z.update_mInv_factor();
+  }
+}
+
+TEST(McmcBlockDenseEMetric, dtau_dp) {
+  stan::mcmc::mock_model model(5);
+  stan::mcmc::block_dense_e_metric<stan::mcmc::mock_model, rng_t>
+    metric(model);
+  stan::mcmc::block_dense_e_point z(5);
+  set_test_blocks(z);
+  z.p << 1, -2, 0.5, 3, -1;
+
+  Eigen::MatrixXd mInv = Eigen::MatrixXd::Zero(5, 5);
+  mInv.block(0, 0, 2, 2) = z.mInv[0];
+  mInv.block(2, 2, 1, 1) = z.mInv[1];
+  mInv.block(3, 3, 2, 2) = z.mInv[2];
+  Eigen::VectorXd expected = mInv * z.p;
+
+  Eigen::VectorXd p_sharp = metric.dtau_dp(z);
+  for (int i = 0; i < 5; ++i)
+    EXPECT_FLOAT_EQ(expected(i), p_sharp(i));
+
+  EXPECT_FLOAT_EQ(0.5 * z.p.dot(expected), metric.tau(z));
+}
+
+TEST(McmcBlockDenseEMetric, sample_p) {
+  rng_t base_rng(0);
+
+  stan::mcmc::mock_model model(5);
+  stan::mcmc::block_dense_e_metric<stan::mcmc::mock_model, rng_t>
+    metric(model);
+  stan::mcmc::block_dense_e_point z(5);
+  set_test_blocks(z);
+
+  int n_samples = 1000;
+  double m = 0;
+  double m2 = 0;
+
+  for (int i = 0; i < n_samples; ++i) {
+    metric.sample_p(z, base_rng);
+    double tau = metric.tau(z);
+
+    double delta = tau - m;
+    m += delta / static_cast<double>(i + 1);
+    m2 += delta * (tau - m);
+  }
+
+  double var = m2 / (n_samples + 1.0);
+
+  // Mean within 5sigma of expected value (d / 2)
+  EXPECT_TRUE(std::fabs(m   - 0.5 * z.q.size()) < 5.0 * sqrt(var));
+
+  // Variance within 10% of expected value (d / 2)
+  EXPECT_TRUE(std::fabs(var - 0.5 * z.q.size()) < 0.1 * z.q.size());
+}
+
+TEST(McmcBlockDenseEMetric, set_blocks) {
+  stan::mcmc::block_dense_e_point z(3);
+  EXPECT_EQ(3U, z.block_sizes.size());
+
+  std::vector<int> sizes;
+  sizes.push_back(2);
+  EXPECT_THROW(z.set_blocks(sizes), std::invalid_argument);
+
+  sizes.push_back(0);
+  sizes.push_back(1);
+  EXPECT_THROW(z.set_blocks(sizes), std::invalid_argument);
+
+  sizes.clear();
+  sizes.push_back(2);
+  sizes.push_back(1);
+  z.set_blocks(sizes);
+  ASSERT_EQ(2U, z.mInv.size());
+  EXPECT_EQ(2, z.mInv[0].rows());
+  EXPECT_EQ(1, z.mInv[1].rows());
+}
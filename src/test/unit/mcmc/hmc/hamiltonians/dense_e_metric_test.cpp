@@ -45,6 +45,37 @@ TEST(McmcDenseEMetric, sample_p) {
   EXPECT_TRUE(std::fabs(var - 0.5 * q.size()) < 0.1 * q.size());
 }
 
+TEST(McmcDenseEMetric, sample_p_cached_factor) {
+  rng_t base_rng(0);
+
+  stan::mcmc::mock_model model(2);
+
+  stan::mcmc::dense_e_metric<stan::mcmc::mock_model, rng_t> metric(model);
+  stan::mcmc::dense_e_point z(2);
+
+  // Inverse metric diag(4, 0.25) gives momentum variances (0.25, 4)
+  z.mInv(0, 0) = 4;
+  z.mInv(1, 1) = 0.25;
+  z.update_mInv_factor();
+
+  int n_samples = 10000;
+  Eigen::VectorXd m2 = Eigen::VectorXd::Zero(2);
+
+  for (int i = 0; i < n_samples; ++i) {
+    metric.sample_p(z, base_rng);
+    m2 += z.p.cwiseProduct(z.p);
+  }
+  m2 /= n_samples;
+
+  EXPECT_NEAR(0.25, m2(0), 0.1 * 0.25);
+  EXPECT_NEAR(4, m2(1), 0.1 * 4);
+
+  // Copies carry the factorization along with the metric
+  stan::mcmc::dense_e_point z_copy(z);
+  EXPECT_FLOAT_EQ(2, z_copy.mInv_L(0, 0));
+  EXPECT_FLOAT_EQ(0.5, z_copy.mInv_L(1, 1));
+}
+
 TEST(McmcDenseEMetric, gradients) {
   rng_t base_rng(0);
 
@@ -140,6 +140,48 @@ TEST(McmcDiagEMetric, gradients) {
   EXPECT_EQ("", error_stream.str());
 }
 
+TEST(McmcDiagEMetric, cached_kinetic) {
+  rng_t base_rng(0);
+
+  Eigen::VectorXd q = Eigen::VectorXd::Ones(11);
+
+  stan::mcmc::diag_e_point z(q.size());
+  z.q = q;
+  z.mInv.setLinSpaced(0.5, 1.5);
+
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream model_output;
+  funnel_model_namespace::funnel_model model(data_var_context, &model_output);
+
+  stan::interface_callbacks::writer::noop_writer writer;
+
+  stan::mcmc::diag_e_metric<funnel_model_namespace::funnel_model, rng_t> metric(model);
+
+  metric.sample_p(z, base_rng);
+  metric.init(z, writer, writer);
+  EXPECT_FALSE(z.kinetic_cached);
+
+  EXPECT_FLOAT_EQ(metric.H(z), metric.H_cached(z));
+  EXPECT_TRUE(z.kinetic_cached);
+  EXPECT_FLOAT_EQ(metric.tau(z), z.tau);
+
+  Eigen::VectorXd p_sharp = metric.dtau_dp(z);
+  for (int i = 0; i < z.q.size(); ++i)
+    EXPECT_FLOAT_EQ(p_sharp(i), z.p_sharp(i));
+
+  stan::mcmc::diag_e_point z_copy(z);
+  EXPECT_TRUE(z_copy.kinetic_cached);
+  EXPECT_FLOAT_EQ(z.tau, z_copy.tau);
+
+  metric.sample_p(z, base_rng);
+  EXPECT_FALSE(z.kinetic_cached);
+  EXPECT_FLOAT_EQ(metric.H(z), metric.H_cached(z));
+  EXPECT_EQ("", model_output.str());
+}
+
 TEST(McmcDiagEMetric, streams) {
   stan::test::capture_std_streams();
 
@@ -0,0 +1,90 @@
+#include <stan/mcmc/hmc/hamiltonians/lowrank_diag_e_metric.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <test/unit/mcmc/hmc/mock_hmc.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+
+typedef boost::ecuyer1988 rng_t;
+
+namespace {
+  // Inverse metric S (I + U diag(lambda) U^T) S with two directions
+  void set_lowrank(stan::mcmc::lowrank_diag_e_point& z) {
+    z.mInv << 4, 1, 0.25;
+    z.mInv_U = Eigen::MatrixXd::Zero(3, 2);
+    Eigen::MatrixXd R(2, 2);
+    R << std::cos(0.3), -std::sin(0.3),
+         std::sin(0.3), std::cos(0.3);
+    z.mInv_U.topRows(2) = R;
+    z.mInv_lambda.resize(2);
+    z.mInv_lambda << 3, -0.5;
+    z.update_mInv_factor();
+  }
+
+  Eigen::MatrixXd dense_mInv(const stan::mcmc::lowrank_diag_e_point& z) {
+    Eigen::MatrixXd inner = Eigen::MatrixXd::Identity(3, 3)
+      + z.mInv_U * z.mInv_lambda.asDiagonal() * z.mInv_U.transpose();
+    return z.mInv_sqrt.asDiagonal() * inner * z.mInv_sqrt.asDiagonal();
+  }
+}
+
+TEST(McmcLowRankDiagEMetric, dtau_dp) {
+  stan::mcmc::mock_model model(3);
+  stan::mcmc::lowrank_diag_e_metric<stan::mcmc::mock_model, rng_t>
+    metric(model);
+  stan::mcmc::lowrank_diag_e_point z(3);
+  set_lowrank(z);
+  z.p << 1, -2, 0.5;
+
+  Eigen::VectorXd expected = dense_mInv(z) * z.p;
+  Eigen::VectorXd p_sharp = metric.dtau_dp(z);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(expected(i), p_sharp(i));
+
+  EXPECT_FLOAT_EQ(0.5 * z.p.dot(expected), metric.tau(z));
+}
+
+TEST(McmcLowRankDiagEMetric, sample_p) {
+  rng_t base_rng(0);
+
+  stan::mcmc::mock_model model(3);
+  stan::mcmc::lowrank_diag_e_metric<stan::mcmc::mock_model, rng_t>
+    metric(model);
+  stan::mcmc::lowrank_diag_e_point z(3);
+  set_lowrank(z);
+
+  int n_samples = 1000;
+  double m = 0;
+  double m2 = 0;
+
+  for (int i = 0; i < n_samples; ++i) {
+    metric.sample_p(z, base_rng);
+    double tau = metric.tau(z);
+
+    double delta = tau - m;
+    m += delta / static_cast<double>(i + 1);
+    m2 += delta * (tau - m);
+  }
+
+  double var = m2 / (n_samples + 1.0);
+
+  // Mean within 5sigma of expected value (d / 2)
+  EXPECT_TRUE(std::fabs(m   - 0.5 * z.q.size()) < 5.0 * sqrt(var));
+
+  // Variance within 10% of expected value (d / 2)
+  EXPECT_TRUE(std::fabs(var - 0.5 * z.q.size()) < 0.1 * z.q.size());
+}
+
+TEST(McmcLowRankDiagEMetric, no_directions_is_diagonal) {
+  stan::mcmc::mock_model model(3);
+  stan::mcmc::lowrank_diag_e_metric<stan::mcmc::mock_model, rng_t>
+    metric(model);
+  stan::mcmc::lowrank_diag_e_point z(3);
+  z.mInv << 4, 1, 0.25;
+  z.update_mInv_factor();
+  z.p << 1, -2, 0.5;
+
+  Eigen::VectorXd p_sharp = metric.dtau_dp(z);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(z.mInv(i) * z.p(i), p_sharp(i));
+}
@@ -0,0 +1,265 @@
+#include <stan/io/dump.hpp>
+#include <stan/mcmc/hmc/hamiltonians/lowrank_softabs_metric.hpp>
+#include <stan/mcmc/hmc/hamiltonians/softabs_metric.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+
+#include <test/test-models/good/mcmc/hmc/hamiltonians/funnel.hpp>
+
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <boost/random/additive_combine.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+typedef boost::ecuyer1988 rng_t;
+typedef funnel_model_namespace::funnel_model model_t;
+typedef stan::mcmc::lowrank_softabs_metric<model_t, rng_t> metric_t;
+
+class McmcLowRankSoftAbs : public testing::Test {
+public:
+  McmcLowRankSoftAbs()
+    : writer(metric_output), error_writer(error_output) {}
+
+  void SetUp() {
+    std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+    stan::io::dump data_var_context(data_stream);
+    data_stream.close();
+    model = new model_t(data_var_context, &model_output);
+  }
+
+  void TearDown() {
+    delete model;
+  }
+
+  std::stringstream model_output;
+  std::stringstream metric_output;
+  std::stringstream error_output;
+  stan::interface_callbacks::writer::stream_writer writer;
+  stan::interface_callbacks::writer::stream_writer error_writer;
+  model_t* model;
+};
+
+TEST_F(McmcLowRankSoftAbs, full_rank_matches_softabs) {
+  stan::mcmc::softabs_metric<model_t, rng_t> full(*model);
+  metric_t lowrank(*model);
+
+  stan::mcmc::softabs_point z_full(11);
+  stan::mcmc::lowrank_softabs_point z(11);
+  z.rank = 11;
+  z.tol = 0;
+  for (int i = 0; i < 11; ++i) {
+    z.q(i) = 0.1 * i - 0.3;
+    z.p(i) = 1 - 0.05 * i;
+  }
+  z_full.q = z.q;
+  z_full.p = z.p;
+
+  full.init(z_full, writer, error_writer);
+  lowrank.init(z, writer, error_writer);
+
+  EXPECT_NEAR(z_full.log_det_metric, z.log_det_metric, 1e-8);
+  EXPECT_NEAR(full.tau(z_full), lowrank.tau(z), 1e-8);
+  EXPECT_NEAR(full.phi(z_full), lowrank.phi(z), 1e-8);
+
+  Eigen::VectorXd a = full.dtau_dp(z_full);
+  Eigen::VectorXd b = lowrank.dtau_dp(z);
+  for (int i = 0; i < 11; ++i)
+    EXPECT_NEAR(a(i), b(i), 1e-8);
+
+  a = full.dtau_dq(z_full, writer, error_writer);
+  b = lowrank.dtau_dq(z, writer, error_writer);
+  for (int i = 0; i < 11; ++i)
+    EXPECT_NEAR(a(i), b(i), 1e-8);
+
+  a = full.dphi_dq(z_full, writer, error_writer);
+  b = lowrank.dphi_dq(z, writer, error_writer);
+  for (int i = 0; i < 11; ++i)
+    EXPECT_NEAR(a(i), b(i), 1e-8);
+
+  EXPECT_EQ("", model_output.str());
+  EXPECT_EQ("", metric_output.str());
+  EXPECT_EQ("", error_output.str());
+}
+
+TEST_F(McmcLowRankSoftAbs, warm_start) {
+  metric_t metric(*model);
+
+  // The eigenvectors of the last update start the next Lanczos
+  // iteration, which must not change the metric
+  stan::mcmc::lowrank_softabs_point z(11);
+  stan::mcmc::lowrank_softabs_point z_cold(11);
+  z.rank = 1;
+  z_cold.rank = 1;
+  z.q.setOnes();
+  metric.init(z, writer, error_writer);
+
+  z.q(0) = 1.1;
+  z_cold.q = z.q;
+  metric.init(z, writer, error_writer);
+  metric.init(z_cold, writer, error_writer);
+
+  EXPECT_NEAR(z_cold.lambda(0), z.lambda(0), 1e-8);
+  EXPECT_NEAR(z_cold.log_det_metric, z.log_det_metric, 1e-8);
+
+  EXPECT_EQ("", model_output.str());
+  EXPECT_EQ("", error_output.str());
+}
+
+TEST_F(McmcLowRankSoftAbs, resolvent_failure_rejects) {
+  metric_t metric(*model);
+
+  stan::mcmc::lowrank_softabs_point z(11);
+  z.rank = 1;
+  z.q.setOnes();
+  z.p.setOnes();
+  z.p(0) = -0.5;
+  metric.init(z, writer, error_writer);
+
+  // Converged solves leave phi finite
+  Eigen::VectorXd g = metric.dtau_dq(z, writer, error_writer);
+  for (int i = 0; i < z.q.size(); ++i)
+    EXPECT_TRUE(boost::math::isfinite(g(i)));
+  EXPECT_FALSE(z.resolvent_failed);
+  EXPECT_TRUE(boost::math::isfinite(metric.phi(z)));
+  EXPECT_EQ("", error_output.str());
+
+  // One Hessian-vector product cannot reach the tolerance, which
+  // is reported once and rejects the trajectory
+  z.max_num_resolvent = 1;
+  metric.dtau_dq(z, writer, error_writer);
+  EXPECT_TRUE(z.resolvent_failed);
+  EXPECT_TRUE(boost::math::isinf(metric.phi(z)));
+  EXPECT_NE(std::string::npos,
+            error_output.str().find("resolvent solve did not converge"));
+
+  std::string reported = error_output.str();
+  metric.dtau_dq(z, writer, error_writer);
+  EXPECT_EQ(reported, error_output.str());
+
+  // The next transition starts over
+  z.max_num_resolvent = 0;
+  metric.init(z, writer, error_writer);
+  EXPECT_FALSE(z.resolvent_failed);
+  EXPECT_TRUE(boost::math::isfinite(metric.phi(z)));
+
+  EXPECT_EQ("", model_output.str());
+}
+
+TEST_F(McmcLowRankSoftAbs, gradients) {
+  metric_t metric(*model);
+
+  // The largest eigenvalue of the funnel Hessian at q = 1 is well
+  // separated, the others include a nine-fold degenerate one
+  stan::mcmc::lowrank_softabs_point z(11);
+  z.rank = 1;
+  // Run the Lanczos iteration over the whole space so finite
+  // differences only see the metric and not its tolerance
+  z.tol = 0;
+  z.q.setOnes();
+  z.p.setOnes();
+  z.p(0) = -0.5;
+
+  double epsilon = 1e-6;
+
+  metric.init(z, writer, error_writer);
+  ASSERT_EQ(1, z.U.cols());
+  Eigen::VectorXd g1 = metric.dtau_dq(z, writer, error_writer);
+
+  for (int i = 0; i < z.q.size(); ++i) {
+    double delta = 0;
+
+    z.q(i) += epsilon;
+    metric.init(z, writer, error_writer);
+    delta += metric.tau(z);
+
+    z.q(i) -= 2 * epsilon;
+    metric.init(z, writer, error_writer);
+    delta -= metric.tau(z);
+
+    z.q(i) += epsilon;
+
+    delta /= 2 * epsilon;
+
+    EXPECT_NEAR(delta, g1(i), 1e-5);
+  }
+
+  metric.init(z, writer, error_writer);
+  Eigen::VectorXd g2 = metric.dtau_dp(z);
+
+  for (int i = 0; i < z.q.size(); ++i) {
+    double delta = 0;
+
+    z.p(i) += epsilon;
+    delta += metric.tau(z);
+
+    z.p(i) -= 2 * epsilon;
+    delta -= metric.tau(z);
+
+    z.p(i) += epsilon;
+
+    delta /= 2 * epsilon;
+
+    EXPECT_NEAR(delta, g2(i), 1e-5);
+  }
+
+  Eigen::VectorXd g3 = metric.dphi_dq(z, writer, error_writer);
+
+  for (int i = 0; i < z.q.size(); ++i) {
+    double delta = 0;
+
+    z.q(i) += epsilon;
+    metric.init(z, writer, error_writer);
+    delta += metric.phi(z);
+
+    z.q(i) -= 2 * epsilon;
+    metric.init(z, writer, error_writer);
+    delta -= metric.phi(z);
+
+    z.q(i) += epsilon;
+
+    delta /= 2 * epsilon;
+
+    EXPECT_NEAR(delta, g3(i), 1e-5);
+  }
+
+  EXPECT_EQ("", model_output.str());
+  EXPECT_EQ("", metric_output.str());
+  EXPECT_EQ("", error_output.str());
+}
+
+TEST_F(McmcLowRankSoftAbs, sample_p) {
+  rng_t base_rng(0);
+  metric_t metric(*model);
+
+  stan::mcmc::lowrank_softabs_point z(11);
+  z.rank = 2;
+  z.tol = 0;
+  z.q.setOnes();
+  metric.init(z, writer, error_writer);
+
+  int n_samples = 1000;
+  double m = 0;
+  double m2 = 0;
+
+  for (int i = 0; i < n_samples; ++i) {
+    metric.sample_p(z, base_rng);
+    double tau = metric.tau(z);
+
+    double delta = tau - m;
+    m += delta / static_cast<double>(i + 1);
+    m2 += delta * (tau - m);
+  }
+
+  double var = m2 / (n_samples + 1.0);
+
+  // Mean within 5sigma of expected value (d / 2)
+  EXPECT_TRUE(std::fabs(m   - 0.5 * z.q.size()) < 5.0 * sqrt(var));
+
+  // Variance within 10% of expected value (d / 2)
+  EXPECT_TRUE(std::fabs(var - 0.5 * z.q.size()) < 0.1 * z.q.size());
+
+  EXPECT_EQ("", metric_output.str());
+}
@@ -0,0 +1,42 @@
+#include <stan/mcmc/hmc/hamiltonians/metric_blocks.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(McmcMetricBlocks, from_names) {
+  std::vector<std::string> names;
+  names.push_back("mu");
+  names.push_back("beta.1");
+  names.push_back("beta.2");
+  names.push_back("beta.3");
+  names.push_back("L.1.1");
+  names.push_back("L.2.1");
+  names.push_back("sigma");
+
+  std::vector<int> sizes;
+  stan::mcmc::metric_blocks_from_names(names, sizes);
+
+  ASSERT_EQ(4U, sizes.size());
+  EXPECT_EQ(1, sizes[0]);
+  EXPECT_EQ(3, sizes[1]);
+  EXPECT_EQ(2, sizes[2]);
+  EXPECT_EQ(1, sizes[3]);
+}
+
+TEST(McmcMetricBlocks, from_string) {
+  std::vector<int> sizes;
+  stan::mcmc::metric_blocks_from_string("3, 1,4", sizes);
+
+  ASSERT_EQ(3U, sizes.size());
+  EXPECT_EQ(3, sizes[0]);
+  EXPECT_EQ(1, sizes[1]);
+  EXPECT_EQ(4, sizes[2]);
+
+  EXPECT_THROW(stan::mcmc::metric_blocks_from_string("3,0", sizes),
+               std::invalid_argument);
+  EXPECT_THROW(stan::mcmc::metric_blocks_from_string("3,a", sizes),
+               std::invalid_argument);
+  EXPECT_THROW(stan::mcmc::metric_blocks_from_string("2.5", sizes),
+               std::invalid_argument);
+}
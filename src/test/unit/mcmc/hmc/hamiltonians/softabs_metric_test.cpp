@@ -151,6 +151,59 @@ TEST(McmcSoftAbs, gradients) {
   EXPECT_EQ("", error_stream.str());
 }
 
+TEST(McmcSoftAbs, dphi_dq_cache) {
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream model_output, metric_output;
+  stan::interface_callbacks::writer::stream_writer writer(metric_output);
+
+  std::stringstream error_stream;
+  stan::interface_callbacks::writer::stream_writer error_writer(error_stream);
+
+  funnel_model_namespace::funnel_model model(data_var_context, &model_output);
+
+  stan::mcmc::softabs_metric<funnel_model_namespace::funnel_model, rng_t> metric(model);
+
+  stan::mcmc::softabs_point z(11);
+  z.q.setOnes();
+  z.p.setOnes();
+
+  stan::mcmc::softabs_point w(11);
+  w.q.setOnes();
+  w.q(0) = -0.5;
+  w.p.setOnes();
+
+  metric.init(z, writer, error_writer);
+  metric.init(w, writer, error_writer);
+  EXPECT_FALSE(z.log_det_grad_cached());
+
+  Eigen::VectorXd g1 = metric.dphi_dq(z, writer, error_writer);
+  EXPECT_TRUE(z.log_det_grad_cached());
+
+  // Moving p keeps the cached term
+  z.p(0) = 2;
+  Eigen::VectorXd g2 = metric.dphi_dq(z, writer, error_writer);
+  for (int i = 0; i < z.q.size(); ++i)
+    EXPECT_EQ(g1(i), g2(i));
+
+  // Restoring another position as the samplers do misses the cache
+  Eigen::VectorXd g3 = metric.dphi_dq(w, writer, error_writer);
+  z.ps_point::operator=(w);
+  EXPECT_FALSE(z.log_det_grad_cached());
+
+  metric.init(z, writer, error_writer);
+  EXPECT_FALSE(z.log_det_grad_cached());
+  Eigen::VectorXd g4 = metric.dphi_dq(z, writer, error_writer);
+  for (int i = 0; i < z.q.size(); ++i)
+    EXPECT_FLOAT_EQ(g3(i), g4(i));
+
+  EXPECT_EQ("", model_output.str());
+  EXPECT_EQ("", metric_output.str());
+  EXPECT_EQ("", error_stream.str());
+}
+
 TEST(McmcSoftAbs, streams) {
   stan::test::capture_std_streams();
   rng_t base_rng(0);
@@ -10,6 +10,9 @@
 #include <stan/mcmc/hmc/hamiltonians/unit_e_metric.hpp>
 #include <stan/mcmc/hmc/hamiltonians/diag_e_metric.hpp>
 #include <boost/random/additive_combine.hpp> // L'Ecuyer RNG
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 typedef boost::ecuyer1988 rng_t;
 
@@ -153,3 +156,74 @@ TEST(McmcHmcIntegratorsExplLeapfrog, symplecticness) {
   EXPECT_EQ("", metric_output.str());
   EXPECT_EQ("", error_stream.str());
 }
+
+// Largest energy error over one period of the oscillator, with the
+// same number of gradients per unit time for every scheme
+double max_energy_error(stan::mcmc::integrator_scheme scheme,
+                        double gradient_epsilon) {
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream output;
+  stan::interface_callbacks::writer::stream_writer writer(output);
+
+  gauss_model_namespace::gauss_model model(data_var_context, &output);
+
+  stan::mcmc::expl_leapfrog<
+    stan::mcmc::unit_e_metric<gauss_model_namespace::gauss_model, rng_t> >
+    integrator;
+  integrator.set_scheme(scheme);
+
+  stan::mcmc::unit_e_metric<gauss_model_namespace::gauss_model, rng_t>
+    metric(model);
+
+  stan::mcmc::unit_e_point z(1);
+  z.q(0) = 1;
+  z.p(0) = 1;
+
+  metric.init(z, writer, writer);
+  double H0 = metric.H(z);
+
+  double epsilon
+    = gradient_epsilon * stan::mcmc::integrator_scheme_stages(scheme);
+  size_t L = 6.28318530717959 / epsilon;
+
+  double max_error = 0;
+  for (size_t n = 0; n < L; ++n) {
+    integrator.evolve(z, metric, epsilon, writer, writer);
+    max_error = std::max(max_error, std::fabs(metric.H(z) - H0));
+  }
+
+  EXPECT_EQ("", output.str());
+  return max_error;
+}
+
+TEST(McmcHmcIntegratorsExplLeapfrog, schemes) {
+  double leapfrog = max_energy_error(stan::mcmc::leapfrog_scheme, 0.1);
+  double two_stage = max_energy_error(stan::mcmc::two_stage_scheme, 0.1);
+  double three_stage = max_energy_error(stan::mcmc::three_stage_scheme, 0.1);
+
+  // Minimum-error splittings beat leapfrog at the same cost
+  EXPECT_LT(two_stage, 0.5 * leapfrog);
+  EXPECT_LT(three_stage, two_stage);
+
+  // Second order for the splittings, fourth order for Yoshida
+  EXPECT_NEAR(4, leapfrog
+              / max_energy_error(stan::mcmc::leapfrog_scheme, 0.05), 0.2);
+  EXPECT_NEAR(4, two_stage
+              / max_energy_error(stan::mcmc::two_stage_scheme, 0.05), 0.2);
+  EXPECT_NEAR(16, max_energy_error(stan::mcmc::yoshida4_scheme, 0.1)
+              / max_energy_error(stan::mcmc::yoshida4_scheme, 0.05), 2);
+}
+
+TEST(McmcHmcIntegratorsExplLeapfrog, scheme_names) {
+  EXPECT_EQ(stan::mcmc::leapfrog_scheme,
+            stan::mcmc::integrator_scheme_from_name("leapfrog"));
+  EXPECT_EQ(stan::mcmc::yoshida4_scheme,
+            stan::mcmc::integrator_scheme_from_name(
+              stan::mcmc::integrator_scheme_name(
+                stan::mcmc::yoshida4_scheme)));
+  EXPECT_THROW(stan::mcmc::integrator_scheme_from_name("euler"),
+               std::invalid_argument);
+}
@@ -13,6 +13,8 @@
 #include <gtest/gtest.h>
 
 #include <sstream>
+#include <string>
+#include <vector>
 
 // namespace
 //************************************************************
@@ -549,3 +551,64 @@ TEST_F(McmcHmcIntegratorsImplLeapfrogF, softabs_streams) {
   EXPECT_EQ("", stan::test::cout_ss.str());
   EXPECT_EQ("", stan::test::cerr_ss.str());
 }
+
+TEST_F(McmcHmcIntegratorsImplLeapfrogF, softabs_fixed_point_statistics) {
+  stan::mcmc::softabs_metric<command_model_namespace::command_model,
+                            rng_t> hamiltonian(*model);
+  double epsilon = 0.1;
+
+  stan::mcmc::softabs_point z(1);
+  z.q(0) =  1.99987371079118;
+  z.p(0) = -1.58612292129732;
+  hamiltonian.init(z, writer, error_writer);
+  stan::mcmc::softabs_point z_init(z);
+
+  std::vector<std::string> names;
+  std::vector<double> values;
+  softabs_integrator.get_param_names(names);
+  softabs_integrator.get_params(values);
+  ASSERT_EQ(2U, names.size());
+  EXPECT_EQ("n_fixed_point__", names[0]);
+  EXPECT_EQ("n_fixed_point_fail__", names[1]);
+  EXPECT_EQ(0, values[0]);
+  EXPECT_EQ(0, values[1]);
+
+  // The metric of a Gaussian is constant, so the momentum update
+  // converges at once and the position update on the second pass
+  softabs_integrator.evolve(z, hamiltonian, epsilon, writer, error_writer);
+  EXPECT_EQ(3, softabs_integrator.num_fixed_point());
+  EXPECT_EQ(0, softabs_integrator.num_fixed_point_fail());
+
+  // A loose enough per-step tolerance accepts the first pass
+  softabs_integrator.reset_statistics();
+  EXPECT_EQ(0, softabs_integrator.num_fixed_point());
+  softabs_integrator.set_adaptive_threshold_scale(1e6);
+  z = z_init;
+  softabs_integrator.evolve(z, hamiltonian, epsilon, writer, error_writer);
+  EXPECT_EQ(2, softabs_integrator.num_fixed_point());
+  EXPECT_EQ(0, softabs_integrator.num_fixed_point_fail());
+
+  // Updates that run out of iterations are counted as failures
+  softabs_integrator.reset_statistics();
+  softabs_integrator.set_adaptive_threshold_scale(0);
+  softabs_integrator.set_max_num_fixed_point(1);
+  z = z_init;
+  softabs_integrator.evolve(z, hamiltonian, epsilon, writer, error_writer);
+  EXPECT_EQ(2, softabs_integrator.num_fixed_point());
+  EXPECT_EQ(1, softabs_integrator.num_fixed_point_fail());
+
+  EXPECT_EQ("", output.str());
+}
+
+TEST_F(McmcHmcIntegratorsImplLeapfrogF, adaptive_threshold_scale_virtual) {
+  // The samplers set the scale through the base integrator
+  stan::mcmc::base_integrator<
+    stan::mcmc::softabs_metric<command_model_namespace::command_model, rng_t> >&
+  base_integrator = softabs_integrator;
+
+  EXPECT_EQ(0, softabs_integrator.adaptive_threshold_scale());
+  base_integrator.set_adaptive_threshold_scale(2.5);
+  EXPECT_EQ(2.5, softabs_integrator.adaptive_threshold_scale());
+  base_integrator.set_adaptive_threshold_scale(-1);
+  EXPECT_EQ(2.5, softabs_integrator.adaptive_threshold_scale());
+}
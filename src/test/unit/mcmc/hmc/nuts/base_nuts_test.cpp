@@ -278,3 +278,51 @@ TEST(McmcNutsBaseNuts, transition) {
   EXPECT_EQ("", output_stream.str());
   EXPECT_EQ("", error_stream.str());
 }
+
+TEST(McmcNutsBaseNuts, build_tree_grows_workspace) {
+
+  rng_t base_rng(0);
+
+  int model_size = 1;
+  double init_momentum = 1.5;
+
+  stan::mcmc::ps_point z_init(model_size);
+  z_init.q(0) = 0;
+  z_init.p(0) = init_momentum;
+
+  stan::mcmc::ps_point z_propose(model_size);
+
+  Eigen::VectorXd rho = z_init.p;
+  double log_sum_weight = -std::numeric_limits<double>::infinity();
+
+  double H0 = -0.1;
+  int n_leapfrog = 0;
+  double sum_metro_prob = 0;
+
+  stan::mcmc::mock_model model(model_size);
+  stan::mcmc::mock_nuts sampler(model, base_rng);
+
+  sampler.set_max_depth(2);
+  sampler.set_nominal_stepsize(1);
+  sampler.set_stepsize_jitter(0);
+  sampler.sample_stepsize();
+  sampler.z() = z_init;
+
+  std::stringstream output;
+  stan::interface_callbacks::writer::stream_writer writer(output);
+  std::stringstream error_stream;
+  stan::interface_callbacks::writer::stream_writer error_writer(error_stream);
+
+  // Deeper than the workspace allocated for max_depth
+  bool valid_subtree = sampler.build_tree(6, rho, z_propose,
+                                          H0, 1, n_leapfrog, log_sum_weight,
+                                          sum_metro_prob, writer, error_writer);
+
+  EXPECT_TRUE(valid_subtree);
+  EXPECT_EQ(64, n_leapfrog);
+  EXPECT_EQ(64 * init_momentum, sampler.z().q(0));
+  EXPECT_EQ(init_momentum * (n_leapfrog + 1), rho(0));
+
+  EXPECT_EQ("", output.str());
+  EXPECT_EQ("", error_stream.str());
+}
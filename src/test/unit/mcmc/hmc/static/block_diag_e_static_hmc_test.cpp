@@ -0,0 +1,81 @@
+#include <stan/mcmc/hmc/static/block_diag_e_static_hmc.hpp>
+#include <stan/mcmc/hmc/static/diag_e_static_hmc.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <test/test-models/good/mcmc/hmc/common/gauss3D.hpp>
+#include <stan/io/dump.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <fstream>
+#include <gtest/gtest.h>
+
+typedef boost::ecuyer1988 rng_t;
+typedef gauss3D_model_namespace::gauss3D_model model_t;
+
+TEST(McmcStaticBlockDiagEStaticHMC, same_draws_single_chain) {
+  std::fstream empty_stream("", std::fstream::in);
+  stan::io::dump data_var_context(empty_stream);
+  model_t model(data_var_context);
+
+  std::stringstream output;
+  stan::interface_callbacks::writer::stream_writer writer(output);
+
+  rng_t rng1(4839294);
+  rng_t rng2(4839294);
+
+  stan::mcmc::diag_e_static_hmc<model_t, rng_t> sampler(model, rng1);
+  stan::mcmc::block_diag_e_static_hmc<model_t, rng_t> block(model, rng2, 1);
+
+  sampler.set_nominal_stepsize_and_L(0.3, 7);
+  block.set_nominal_stepsize_and_L(0.3, 7);
+  sampler.z().mInv << 0.5, 1, 2;
+  block.inv_e_metric() << 0.5, 1, 2;
+
+  Eigen::VectorXd q(3);
+  q << 1, -1, 1;
+  stan::mcmc::sample s(q, 0, 0);
+  Eigen::MatrixXd Q = q;
+
+  for (int n = 0; n < 100; ++n) {
+    s = sampler.transition(s, writer, writer);
+    block.transition(Q, writer, writer);
+
+    for (int i = 0; i < q.size(); ++i)
+      EXPECT_EQ(s.cont_params()(i), Q(i, 0));
+    EXPECT_EQ(s.log_prob(), block.log_prob()(0));
+    EXPECT_EQ(s.accept_stat(), block.accept_stat()(0));
+  }
+
+  EXPECT_EQ("", output.str());
+}
+
+TEST(McmcStaticBlockDiagEStaticHMC, transition) {
+  std::fstream empty_stream("", std::fstream::in);
+  stan::io::dump data_var_context(empty_stream);
+  model_t model(data_var_context);
+
+  std::stringstream output;
+  stan::interface_callbacks::writer::stream_writer writer(output);
+
+  rng_t rng(4839294);
+  const int num_chains = 8;
+  stan::mcmc::block_diag_e_static_hmc<model_t, rng_t>
+    block(model, rng, num_chains);
+  block.set_nominal_stepsize_and_T(0.2, 1.0);
+  EXPECT_EQ(5, block.get_L());
+  EXPECT_EQ(num_chains, block.num_chains());
+
+  Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(3, num_chains);
+  for (int n = 0; n < 10; ++n)
+    block.transition(Q, writer, writer);
+
+  EXPECT_EQ(3, Q.rows());
+  EXPECT_EQ(num_chains, Q.cols());
+  for (int k = 0; k < num_chains; ++k) {
+    EXPECT_TRUE(boost::math::isfinite(block.log_prob()(k)));
+    EXPECT_GE(block.accept_stat()(k), 0);
+    EXPECT_LE(block.accept_stat()(k), 1);
+  }
+  // Chains share the random stream but not their draws
+  EXPECT_NE(Q(0, 0), Q(0, 1));
+
+  EXPECT_EQ("", output.str());
+}
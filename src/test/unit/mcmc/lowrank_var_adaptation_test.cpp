@@ -0,0 +1,171 @@
+#include <stan/mcmc/lowrank_var_adaptation.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+
+TEST(McmcLowRankVarAdaptation, learn_lowrank_constant) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  const int n = 10;
+  Eigen::VectorXd q = Eigen::VectorXd::Zero(n);
+  Eigen::VectorXd var(Eigen::VectorXd::Zero(n));
+  Eigen::MatrixXd U;
+  Eigen::VectorXd lambda;
+
+  const int n_learn = 10;
+
+  Eigen::VectorXd target_var(Eigen::VectorXd::Ones(n));
+  target_var *= 1e-3 * 5.0 / (n_learn + 5.0);
+
+  stan::mcmc::lowrank_var_adaptation adapter(n);
+  adapter.set_window_params(50, 0, 0, n_learn, writer);
+
+  bool update = false;
+  for (int i = 0; i < n_learn; ++i)
+    update = adapter.learn_lowrank(var, U, lambda, q);
+
+  EXPECT_TRUE(update);
+  for (int i = 0; i < n; ++i)
+    EXPECT_EQ(target_var(i), var(i));
+
+  // Constant draws have no correlations to keep
+  for (int j = 0; j < lambda.size(); ++j)
+    EXPECT_NEAR(-static_cast<double>(n_learn) / (n_learn + 5.0),
+                lambda(j), 1e-12);
+
+  EXPECT_EQ("", ss.str());
+}
+
+TEST(McmcLowRankVarAdaptation, learn_lowrank_correlated) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  boost::ecuyer1988 rng(0);
+  boost::variate_generator<boost::ecuyer1988&, boost::normal_distribution<> >
+    rand_unit_gaus(rng, boost::normal_distribution<>());
+
+  // Draws with unit marginal variances and one strongly
+  // correlated pair
+  const int n = 5;
+  const int n_learn = 2000;
+  const double rho = 0.9;
+
+  stan::mcmc::lowrank_var_adaptation adapter(n);
+  adapter.set_rank(1);
+  adapter.set_window_params(5000, 0, 0, n_learn, writer);
+
+  Eigen::VectorXd var(n);
+  Eigen::MatrixXd U;
+  Eigen::VectorXd lambda;
+  Eigen::VectorXd q(n);
+
+  bool update = false;
+  for (int i = 0; i < n_learn; ++i) {
+    for (int d = 0; d < n; ++d)
+      q(d) = rand_unit_gaus();
+    q(1) = rho * q(0) + std::sqrt(1 - rho * rho) * q(1);
+    update = adapter.learn_lowrank(var, U, lambda, q);
+  }
+
+  ASSERT_TRUE(update);
+  ASSERT_EQ(1, U.cols());
+  ASSERT_EQ(1, lambda.size());
+
+  for (int d = 0; d < n; ++d)
+    EXPECT_NEAR(1, var(d), 0.1);
+
+  // Leading direction (1, 1) / sqrt(2) with eigenvalue 1 + rho
+  EXPECT_NEAR(1, U.col(0).norm(), 1e-10);
+  EXPECT_NEAR(1 / std::sqrt(2.0), std::fabs(U(0, 0)), 0.05);
+  EXPECT_NEAR(1 / std::sqrt(2.0), std::fabs(U(1, 0)), 0.05);
+  EXPECT_NEAR(rho, lambda(0), 0.1);
+
+  EXPECT_EQ("", ss.str());
+}
+
+TEST(McmcLowRankVarAdaptation, state_does_not_grow) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  const int n = 20;
+  Eigen::VectorXd var(n);
+  Eigen::MatrixXd U;
+  Eigen::VectorXd lambda;
+  Eigen::VectorXd q(n);
+
+  stan::mcmc::lowrank_var_adaptation adapter(n);
+  adapter.set_rank(2);
+  adapter.set_window_params(5000, 0, 0, 2000, writer);
+
+  std::stringstream state_short;
+  std::stringstream state_long;
+  for (int i = 0; i < 1000; ++i) {
+    for (int d = 0; d < n; ++d)
+      q(d) = std::sin(i + 3.0 * d);
+    adapter.learn_lowrank(var, U, lambda, q);
+    if (i == 9)
+      adapter.write_state(state_short);
+  }
+  adapter.write_state(state_long);
+
+  // The sketch replaces the draws, so the state keeps its size
+  EXPECT_NEAR(static_cast<double>(state_short.str().size()),
+              static_cast<double>(state_long.str().size()),
+              0.1 * state_short.str().size());
+
+  stan::mcmc::lowrank_var_adaptation restored(n);
+  restored.read_state(state_long);
+  std::stringstream state_restored;
+  restored.write_state(state_restored);
+  EXPECT_EQ(state_long.str(), state_restored.str());
+
+  EXPECT_EQ("", ss.str());
+}
+
+TEST(McmcLowRankVarAdaptation, learn_lowrank_sketched) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  boost::ecuyer1988 rng(1);
+  boost::variate_generator<boost::ecuyer1988&, boost::normal_distribution<> >
+    rand_unit_gaus(rng, boost::normal_distribution<>());
+
+  // More parameters than test vectors, with a block of five
+  // parameters with correlation 0.9
+  const int n = 50;
+  const int n_learn = 3000;
+
+  stan::mcmc::lowrank_var_adaptation adapter(n);
+  adapter.set_rank(2);
+  adapter.set_window_params(5000, 0, 0, n_learn, writer);
+
+  Eigen::VectorXd var(n);
+  Eigen::MatrixXd U;
+  Eigen::VectorXd lambda;
+  Eigen::VectorXd q(n);
+
+  bool update = false;
+  for (int i = 0; i < n_learn; ++i) {
+    for (int d = 0; d < n; ++d)
+      q(d) = rand_unit_gaus() * (1 + d % 3);
+    double z = rand_unit_gaus();
+    for (int d = 0; d < 5; ++d)
+      q(d) += 3 * z * (1 + d % 3);
+    update = adapter.learn_lowrank(var, U, lambda, q);
+  }
+
+  ASSERT_TRUE(update);
+  ASSERT_EQ(2, U.cols());
+
+  // Leading eigenvalue 1 + 4 * 0.9 of the correlation matrix
+  EXPECT_NEAR(3.6, lambda(0), 0.2);
+  EXPECT_GT(0.5, lambda(1));
+  for (int d = 0; d < 5; ++d)
+    EXPECT_NEAR(1 / std::sqrt(5.0), std::fabs(U(d, 0)), 0.05);
+
+  EXPECT_EQ("", ss.str());
+}
@@ -170,3 +170,92 @@ TEST(McmcStepsizeAdaptation, learn_stepsize_3) {
   EXPECT_NEAR(0.75, adaptation.kappa(), 1e-14);
   EXPECT_NEAR(10, adaptation.t0(), 1e-14);
 }
+
+TEST(McmcStepsizeAdaptation, complete_adaptation_pooled) {
+  exposed_adaptation adaptation_1(10, 0, 0.2, 0, 0.5, 0.05, 0.75, 10);
+  exposed_adaptation adaptation_2(10, 0, 0.6, 0, 0.5, 0.05, 0.75, 10);
+
+  std::vector<stan::mcmc::stepsize_adaptation*> pool;
+  pool.push_back(&adaptation_1);
+  pool.push_back(&adaptation_2);
+  adaptation_1.set_pool(pool);
+  adaptation_2.set_pool(pool);
+
+  double epsilon_1 = 0;
+  double epsilon_2 = 0;
+  adaptation_1.complete_adaptation(epsilon_1);
+  adaptation_2.complete_adaptation(epsilon_2);
+  EXPECT_FLOAT_EQ(std::exp(0.4), epsilon_1);
+  EXPECT_EQ(epsilon_1, epsilon_2);
+}
+
+TEST(McmcStepsizeAdaptation, pool_stepsize_at_window_boundary) {
+  exposed_adaptation adaptation_1(10, 0, 0.2, 0, 0.5, 0.05, 0.75, 10);
+  exposed_adaptation adaptation_2(10, 0, 0.6, 0, 0.5, 0.05, 0.75, 10);
+
+  double epsilon_1 = 3;
+  adaptation_1.pool_stepsize(epsilon_1);
+  EXPECT_EQ(3, epsilon_1);
+
+  std::vector<stan::mcmc::stepsize_adaptation*> pool;
+  pool.push_back(&adaptation_1);
+  pool.push_back(&adaptation_2);
+  adaptation_1.set_pool(pool);
+  adaptation_2.set_pool(pool);
+
+  // The first chain restarts before the second reaches the boundary
+  adaptation_1.pool_stepsize(epsilon_1);
+  adaptation_1.restart();
+  double epsilon_2 = 0;
+  adaptation_2.pool_stepsize(epsilon_2);
+  adaptation_2.restart();
+
+  EXPECT_FLOAT_EQ(std::exp(0.4), epsilon_1);
+  EXPECT_EQ(epsilon_1, epsilon_2);
+
+  adaptation_1.learn_stepsize(epsilon_1, 0.5);
+  EXPECT_EQ(1, adaptation_1.counter());
+  EXPECT_EQ(0.6, adaptation_2.x_bar());
+}
+
+TEST(McmcStepsizeAdaptation, complete_adaptation_pooled_restarted) {
+  exposed_adaptation adaptation_1(10, 0, 0.2, 0, 0.5, 0.05, 0.75, 10);
+  exposed_adaptation adaptation_2(10, 0, 0.6, 0, 0.5, 0.05, 0.75, 10);
+
+  std::vector<stan::mcmc::stepsize_adaptation*> pool;
+  pool.push_back(&adaptation_1);
+  pool.push_back(&adaptation_2);
+  adaptation_1.set_pool(pool);
+  adaptation_2.set_pool(pool);
+
+  // Only the chain that has not restarted contributes
+  adaptation_1.restart();
+  double epsilon = 0;
+  adaptation_2.complete_adaptation(epsilon);
+  EXPECT_FLOAT_EQ(std::exp(0.6), epsilon);
+
+  // With every chain restarted each keeps its own step size
+  adaptation_2.restart();
+  adaptation_1.complete_adaptation(epsilon);
+  EXPECT_FLOAT_EQ(std::exp(0.2), epsilon);
+}
+
+TEST(McmcStepsizeAdaptation, pool_of_one_chain) {
+  exposed_adaptation adaptation(10, 0, 0.2, 0, 0.5, 0.05, 0.75, 10);
+
+  std::vector<stan::mcmc::stepsize_adaptation*> pool;
+  pool.push_back(&adaptation);
+  adaptation.set_pool(pool);
+
+  double epsilon = 3;
+  EXPECT_FALSE(adaptation.pool_stepsize(epsilon));
+  EXPECT_EQ(3, epsilon);
+
+  adaptation.complete_adaptation(epsilon);
+  EXPECT_FLOAT_EQ(std::exp(0.2), epsilon);
+
+  // A single chain restarts at once, as without a pool
+  adaptation.restart();
+  EXPECT_EQ(0, adaptation.counter());
+  EXPECT_EQ(0, adaptation.x_bar());
+}
@@ -0,0 +1,80 @@
+#include <stan/mcmc/transition_profile.hpp>
+#include <stan/mcmc/hmc/nuts/unit_e_nuts.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <test/test-models/good/mcmc/hmc/common/gauss3D.hpp>
+#include <stan/io/dump.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <fstream>
+#include <gtest/gtest.h>
+
+typedef boost::ecuyer1988 rng_t;
+typedef stan::mcmc::transition_profile profile_t;
+
+TEST(McmcTransitionProfile, phases) {
+  profile_t profile;
+  EXPECT_EQ(0, profile.num_iterations());
+
+  profile.begin(profile_t::gradient_phase);
+  profile.end(profile_t::gradient_phase);
+  profile.begin(profile_t::gradient_phase);
+  profile.end(profile_t::gradient_phase);
+  EXPECT_EQ(0, profile.total_calls(profile_t::gradient_phase));
+
+  profile.end_iteration();
+  EXPECT_EQ(1, profile.num_iterations());
+  EXPECT_EQ(2, profile.total_calls(profile_t::gradient_phase));
+  EXPECT_EQ(0, profile.total_calls(profile_t::rng_phase));
+  EXPECT_GE(profile.total_time(profile_t::gradient_phase), 0);
+
+  std::stringstream output;
+  stan::interface_callbacks::writer::stream_writer writer(output);
+  profile.write_summary(writer);
+  EXPECT_NE(std::string::npos, output.str().find("Profile of 1 iterations"));
+  EXPECT_NE(std::string::npos, output.str().find("gradient"));
+
+  profile.reset();
+  EXPECT_EQ(0, profile.num_iterations());
+  EXPECT_EQ(0, profile.total_calls(profile_t::gradient_phase));
+}
+
+TEST(McmcTransitionProfile, unit_e_nuts) {
+  std::fstream empty_stream("", std::fstream::in);
+  stan::io::dump data_var_context(empty_stream);
+  gauss3D_model_namespace::gauss3D_model model(data_var_context);
+
+  rng_t rng(4839294);
+  stan::mcmc::unit_e_nuts<gauss3D_model_namespace::gauss3D_model, rng_t>
+    sampler(model, rng);
+
+  std::stringstream output;
+  stan::interface_callbacks::writer::stream_writer writer(output);
+
+  Eigen::VectorXd q(3);
+  q << 1, -1, 1;
+  stan::mcmc::sample s(q, 0, 0);
+
+  profile_t profile;
+  sampler.set_profile(&profile);
+  s = sampler.transition(s, writer, writer);
+  profile.end_iteration();
+  sampler.set_profile(0);
+
+  std::vector<double> values;
+  sampler.get_sampler_params(values);
+  long n_leapfrog = static_cast<long>(values[2]);
+
+  // One gradient at the initial point and one per leapfrog step
+  EXPECT_EQ(n_leapfrog + 1, profile.total_calls(profile_t::gradient_phase));
+  EXPECT_EQ(n_leapfrog, profile.total_calls(profile_t::integrator_phase));
+  EXPECT_EQ(1, profile.total_calls(profile_t::rng_phase));
+  // A velocity for each position update and a kinetic energy
+  // after each step
+  EXPECT_GE(profile.total_calls(profile_t::kinetic_phase),
+            2 * n_leapfrog + 1);
+
+  s = sampler.transition(s, writer, writer);
+  profile.end_iteration();
+  EXPECT_EQ(1, profile.total_calls(profile_t::rng_phase));
+
+  EXPECT_EQ("", output.str());
+}
@@ -26,3 +26,128 @@ TEST(McmcVarAdaptation, learn_variance) {
 
   EXPECT_EQ("", ss.str());
 }
+
+TEST(McmcVarAdaptation, learn_variance_pooled) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  const int n = 3;
+  const int n_learn = 10;
+
+  stan::mcmc::var_adaptation adapter_1(n);
+  stan::mcmc::var_adaptation adapter_2(n);
+  adapter_1.set_window_params(50, 0, 0, n_learn, writer);
+  adapter_2.set_window_params(50, 0, 0, n_learn, writer);
+
+  std::vector<stan::mcmc::var_adaptation*> pool;
+  pool.push_back(&adapter_1);
+  pool.push_back(&adapter_2);
+  adapter_1.set_pool(pool);
+  adapter_2.set_pool(pool);
+
+  Eigen::VectorXd var_1(Eigen::VectorXd::Zero(n));
+  Eigen::VectorXd var_2(Eigen::VectorXd::Zero(n));
+
+  // The draw at the window boundary is not pooled
+  std::vector<double> draws;
+  bool update_1 = false;
+  bool update_2 = false;
+  for (int i = 0; i < n_learn; ++i) {
+    Eigen::VectorXd q_1 = Eigen::VectorXd::Constant(n, i);
+    Eigen::VectorXd q_2 = Eigen::VectorXd::Constant(n, -2.0 * i);
+    update_1 = adapter_1.learn_variance(var_1, q_1);
+    update_2 = adapter_2.learn_variance(var_2, q_2);
+    if (i < n_learn - 1) {
+      draws.push_back(i);
+      draws.push_back(-2.0 * i);
+    }
+  }
+  EXPECT_TRUE(update_1);
+  EXPECT_TRUE(update_2);
+
+  double n_draws = draws.size();
+  double mean = 0;
+  for (size_t i = 0; i < draws.size(); ++i)
+    mean += draws[i] / n_draws;
+  double target_var = 0;
+  for (size_t i = 0; i < draws.size(); ++i)
+    target_var += (draws[i] - mean) * (draws[i] - mean) / (n_draws - 1);
+  target_var = (n_draws / (n_draws + 5.0)) * target_var
+    + 1e-3 * (5.0 / (n_draws + 5.0));
+
+  for (int i = 0; i < n; ++i) {
+    EXPECT_FLOAT_EQ(target_var, var_1(i));
+    EXPECT_EQ(var_1(i), var_2(i));
+  }
+
+  EXPECT_EQ("", ss.str());
+}
+
+TEST(McmcVarAdaptation, learn_variance_pool_of_one) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  const int n = 3;
+  const int n_learn = 10;
+
+  stan::mcmc::var_adaptation adapter(n);
+  stan::mcmc::var_adaptation pooled_adapter(n);
+  adapter.set_window_params(50, 0, 0, n_learn, writer);
+  pooled_adapter.set_window_params(50, 0, 0, n_learn, writer);
+
+  std::vector<stan::mcmc::var_adaptation*> pool;
+  pool.push_back(&pooled_adapter);
+  pooled_adapter.set_pool(pool);
+
+  // A single chain keeps the draw at the window boundary
+  Eigen::VectorXd var(Eigen::VectorXd::Zero(n));
+  Eigen::VectorXd pooled_var(Eigen::VectorXd::Zero(n));
+  for (int i = 0; i < 2 * n_learn; ++i) {
+    Eigen::VectorXd q = Eigen::VectorXd::Constant(n, i * i);
+    EXPECT_EQ(adapter.learn_variance(var, q),
+              pooled_adapter.learn_variance(pooled_var, q));
+    for (int j = 0; j < n; ++j)
+      EXPECT_EQ(var(j), pooled_var(j));
+  }
+
+  EXPECT_EQ("", ss.str());
+}
+
+TEST(McmcVarAdaptation, zero_window_keeps_metric) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  const int n = 2;
+  Eigen::VectorXd q = Eigen::VectorXd::Zero(n);
+  Eigen::VectorXd var(Eigen::VectorXd::Constant(n, 3));
+
+  stan::mcmc::var_adaptation adapter(n);
+  adapter.set_window_params(50, 10, 10, 0, writer);
+
+  for (int i = 0; i < 50; ++i)
+    EXPECT_FALSE(adapter.learn_variance(var, q));
+
+  EXPECT_EQ(3, var(0));
+  EXPECT_EQ(3, var(1));
+  EXPECT_EQ("", ss.str());
+}
+
+TEST(McmcVarAdaptation, zero_window_keeps_metric_on_overflow) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  const int n = 2;
+  Eigen::VectorXd q = Eigen::VectorXd::Zero(n);
+  Eigen::VectorXd var(Eigen::VectorXd::Constant(n, 3));
+
+  // The buffers overflow the warmup, so they are repartitioned
+  stan::mcmc::var_adaptation adapter(n);
+  adapter.set_window_params(100, 75, 50, 0, writer);
+
+  for (int i = 0; i < 100; ++i)
+    EXPECT_FALSE(adapter.learn_variance(var, q));
+
+  EXPECT_EQ(3, var(0));
+  EXPECT_EQ(3, var(1));
+  EXPECT_NE(std::string::npos, ss.str().find("adapt_window = 0"));
+}
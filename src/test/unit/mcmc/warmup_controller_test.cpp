@@ -0,0 +1,109 @@
+#include <stan/mcmc/warmup_controller.hpp>
+#include <stan/mcmc/var_adaptation.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+
+TEST(McmcWarmupController, stepsize_only) {
+  stan::mcmc::stepsize_adaptation stepsize;
+  stepsize.set_mu(0.5);
+  stepsize.set_delta(0.8);
+
+  stan::mcmc::warmup_controller controller(stepsize, 0, 20, 100);
+  controller.set_stepsize_window(5);
+
+  // An acceptance statistic on target leaves the step size at mu
+  double epsilon = 1;
+  for (int i = 1; i < 20; ++i) {
+    stepsize.learn_stepsize(epsilon, 0.8);
+    EXPECT_FALSE(controller.update());
+  }
+  stepsize.learn_stepsize(epsilon, 0.8);
+  EXPECT_TRUE(controller.update());
+  EXPECT_EQ(20U, controller.iteration());
+}
+
+TEST(McmcWarmupController, unstable_stepsize) {
+  stan::mcmc::stepsize_adaptation stepsize;
+  stepsize.set_delta(0.8);
+
+  stan::mcmc::warmup_controller controller(stepsize, 0, 0, 30);
+  controller.set_stepsize_window(5);
+
+  // Alternating acceptance keeps the averaged step size moving
+  double epsilon = 1;
+  for (int i = 1; i < 30; ++i) {
+    stepsize.learn_stepsize(epsilon, i % 2 ? 0 : 1);
+    EXPECT_FALSE(controller.update());
+  }
+  stepsize.learn_stepsize(epsilon, 0.8);
+  EXPECT_TRUE(controller.update());
+}
+
+TEST(McmcWarmupController, metric_windows) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  const int n = 3;
+  stan::mcmc::stepsize_adaptation stepsize;
+  stan::mcmc::var_adaptation metric(n);
+  metric.set_window_params(500, 0, 0, 50, writer);
+
+  stan::mcmc::warmup_controller controller(stepsize, &metric, 0, 500);
+  controller.set_stepsize_window(1);
+
+  // Draws with the same spread in every window give a stable
+  // metric once the second window ends
+  Eigen::VectorXd var = Eigen::VectorXd::Ones(n);
+  Eigen::VectorXd q(n);
+  int i = 0;
+  bool done = false;
+  while (!done) {
+    q.setConstant(i % 2 ? 1 : -1);
+    metric.learn_variance(var, q);
+    done = controller.update();
+    ++i;
+    if (metric.num_windows() < 2) {
+      EXPECT_FALSE(done);
+    }
+  }
+
+  EXPECT_EQ(2U, metric.num_windows());
+  EXPECT_LT(metric.window_change(), 0.1);
+  EXPECT_EQ(150, i);
+  EXPECT_EQ("", ss.str());
+}
+
+TEST(McmcWarmupController, no_metric_windows) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+
+  stan::mcmc::stepsize_adaptation stepsize;
+  stepsize.set_mu(0.5);
+  stepsize.set_delta(0.8);
+
+  // A zero base window keeps the metric, so only the step size
+  // decides when warmup ends
+  stan::mcmc::var_adaptation metric(3);
+  metric.set_window_params(500, 10, 10, 0, writer);
+  EXPECT_FALSE(metric.windows_scheduled());
+
+  stan::mcmc::warmup_controller controller(stepsize, &metric, 20, 500);
+  controller.set_stepsize_window(5);
+
+  double epsilon = 1;
+  for (int i = 1; i < 20; ++i) {
+    stepsize.learn_stepsize(epsilon, 0.8);
+    EXPECT_FALSE(controller.update());
+  }
+  stepsize.learn_stepsize(epsilon, 0.8);
+  EXPECT_TRUE(controller.update());
+
+  // As does num_warmup < 20, which turns off the estimation
+  stan::mcmc::var_adaptation short_metric(3);
+  short_metric.set_window_params(10, 0, 0, 5, writer);
+  EXPECT_FALSE(short_metric.windows_scheduled());
+  stan::mcmc::warmup_controller short_controller(stepsize, &short_metric,
+                                                 0, 10);
+  EXPECT_TRUE(short_controller.metric_stable());
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <stan/model/counting_model.hpp>
+#include <stan/model/util.hpp>
+#include <stan/interface_callbacks/interrupt/gradient_budget.hpp>
+#include <stan/io/dump.hpp>
+#include <test/test-models/good/model/valid.hpp>
+
+typedef valid_model_namespace::valid_model model_t;
+
+TEST(ModelCountingModel, counts) {
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream output;
+  model_t model(data_var_context, &output);
+  stan::model::counting_model<model_t> counting(model);
+
+  EXPECT_EQ(model.num_params_r(), counting.num_params_r());
+  EXPECT_EQ(model_t::model_name(),
+            stan::model::counting_model<model_t>::model_name());
+
+  int dim = counting.num_params_r();
+  Eigen::VectorXd x = Eigen::VectorXd::Constant(dim, 0.3);
+  double f, f_counted;
+  Eigen::VectorXd g(dim), g_counted(dim);
+
+  stan::model::gradient(model, x, f, g);
+  stan::model::gradient(counting, x, f_counted, g_counted);
+  EXPECT_FLOAT_EQ(f, f_counted);
+  for (int i = 0; i < dim; ++i)
+    EXPECT_FLOAT_EQ(g(i), g_counted(i));
+  EXPECT_EQ(1, counting.num_gradients());
+  EXPECT_EQ(1, counting.num_log_probs());
+
+  // Evaluated with autodiff scalars, but not a gradient
+  stan::model::log_prob_propto<true>(counting, x);
+  EXPECT_EQ(2, counting.num_log_probs());
+  EXPECT_EQ(1, counting.num_gradients());
+
+  counting.template log_prob<false, false>(x);
+  EXPECT_EQ(3, counting.num_log_probs());
+  EXPECT_EQ(1, counting.num_gradients());
+
+  std::vector<double> x_r(dim, 0.3);
+  std::vector<int> x_i;
+  std::vector<double> g_r;
+  stan::model::log_prob_grad<true, true>(counting, x_r, x_i, g_r);
+  EXPECT_EQ(2, counting.num_gradients());
+
+  Eigen::VectorXd v = Eigen::VectorXd::Ones(dim);
+  Eigen::VectorXd hv;
+  stan::model::hessian_times_vector(counting, x, v, f, hv);
+  EXPECT_EQ(2, counting.num_gradients());
+
+  EXPECT_FALSE(counting.budget_exhausted());
+  counting.reset_counts();
+  EXPECT_EQ(0, counting.num_gradients());
+  EXPECT_EQ(0, counting.num_log_probs());
+
+  EXPECT_EQ("", output.str());
+}
+
+TEST(ModelCountingModel, gradient_budget) {
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream output;
+  model_t model(data_var_context, &output);
+  stan::model::counting_model<model_t> counting(model, 2);
+  stan::interface_callbacks::interrupt::gradient_budget<model_t>
+    interrupt(counting);
+
+  int dim = counting.num_params_r();
+  Eigen::VectorXd x = Eigen::VectorXd::Constant(dim, 0.3);
+  double f;
+  Eigen::VectorXd g(dim);
+
+  stan::model::gradient(counting, x, f, g);
+  EXPECT_NO_THROW(interrupt());
+  EXPECT_FALSE(counting.budget_exhausted());
+
+  stan::model::gradient(counting, x, f, g);
+  EXPECT_TRUE(counting.budget_exhausted());
+  EXPECT_THROW(interrupt(), stan::model::gradient_budget_exhausted);
+
+  try {
+    interrupt();
+  } catch (const stan::model::gradient_budget_exhausted& e) {
+    EXPECT_EQ(2, e.num_gradients());
+  }
+
+  EXPECT_EQ("", output.str());
+}
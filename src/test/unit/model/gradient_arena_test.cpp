@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <stan/model/gradient_arena.hpp>
+#include <stan/model/util.hpp>
+#include <stan/io/dump.hpp>
+#include <test/test-models/good/model/valid.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+
+TEST(ModelGradientArena, gradient) {
+  int dim = 5;
+
+  Eigen::VectorXd x = Eigen::VectorXd::Constant(dim, 0.3);
+  double f, f_arena;
+  Eigen::VectorXd g(dim), g_arena(dim);
+
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream output;
+  valid_model_namespace::valid_model valid_model(data_var_context, &output);
+
+  stan::model::gradient_arena arena;
+  EXPECT_EQ(0, arena.num_gradients());
+  EXPECT_EQ(0U, arena.max_var_stack_size());
+
+  stan::model::gradient(valid_model, x, f, g);
+  EXPECT_NO_THROW(arena.gradient(valid_model, x, f_arena, g_arena));
+
+  EXPECT_FLOAT_EQ(f, f_arena);
+  for (int i = 0; i < dim; ++i)
+    EXPECT_FLOAT_EQ(g(i), g_arena(i));
+
+  size_t max_var_stack_size = arena.max_var_stack_size();
+  size_t max_bytes_allocated = arena.max_bytes_allocated();
+  EXPECT_EQ(1, arena.num_gradients());
+  EXPECT_GE(max_var_stack_size, static_cast<size_t>(dim));
+  EXPECT_GT(max_bytes_allocated, 0U);
+  EXPECT_EQ(0U, stan::math::ChainableStack::var_stack_.size());
+
+  // The same tape fits in the memory kept from the first gradient
+  stan::interface_callbacks::writer::stream_writer writer(output);
+  EXPECT_NO_THROW(arena.gradient(valid_model, x, f_arena, g_arena, writer));
+  EXPECT_EQ(2, arena.num_gradients());
+  EXPECT_EQ(max_var_stack_size, arena.max_var_stack_size());
+  EXPECT_EQ(max_bytes_allocated, arena.max_bytes_allocated());
+
+  arena.reset_statistics();
+  EXPECT_EQ(0, arena.num_gradients());
+  EXPECT_EQ(0U, arena.max_bytes_allocated());
+
+  EXPECT_EQ("", output.str());
+}
@@ -164,6 +164,41 @@ TEST(ModelUtil, gradient_writer) {
   //EXPECT_EQ("", output.str());
 }
 
+TEST(ModelUtil, gradients) {
+  int dim = 5;
+  int n_points = 3;
+
+  Eigen::MatrixXd x(dim, n_points);
+  for (int k = 0; k < n_points; ++k)
+    x.col(k).setConstant(0.1 * (k + 1));
+  Eigen::VectorXd f;
+  Eigen::MatrixXd g;
+
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream output;
+  valid_model_namespace::valid_model valid_model(data_var_context, &output);
+  EXPECT_NO_THROW(stan::model::gradients(valid_model, x, f, g));
+
+  ASSERT_EQ(n_points, f.size());
+  ASSERT_EQ(dim, g.rows());
+  ASSERT_EQ(n_points, g.cols());
+
+  for (int k = 0; k < n_points; ++k) {
+    Eigen::VectorXd x_k = x.col(k);
+    double f_k;
+    Eigen::VectorXd g_k(dim);
+    stan::model::gradient(valid_model, x_k, f_k, g_k);
+    EXPECT_FLOAT_EQ(f_k, f(k));
+    for (int i = 0; i < dim; ++i)
+      EXPECT_FLOAT_EQ(g_k(i), g(i, k));
+  }
+
+  EXPECT_EQ("", output.str());
+}
+
 TEST(ModelUtil, hessian) {
   
   int dim = 5;
@@ -0,0 +1,135 @@
+#include <stan/services/mcmc/run_chains.hpp>
+#include <stan/services/mcmc/create_chain_rngs.hpp>
+#include <gtest/gtest.h>
+#include <test/test-models/good/services/test_lp.hpp>
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <sstream>
+
+typedef boost::ecuyer1988 rng_t;
+typedef stan::interface_callbacks::writer::stream_writer writer_t;
+typedef stan::services::sample::mcmc_writer<stan_model,
+                                            writer_t,
+                                            writer_t,
+                                            writer_t> mcmc_writer_t;
+
+class mock_adaptive_sampler : public stan::mcmc::base_mcmc,
+                              public stan::mcmc::base_adapter {
+public:
+  mock_adaptive_sampler()
+    : base_mcmc(), n_transition_called(0), n_adapting_called(0) { }
+
+  stan::mcmc::sample transition(stan::mcmc::sample& init_sample,
+                                stan::interface_callbacks::writer::base_writer& info_writer,
+                                stan::interface_callbacks::writer::base_writer& error_writer) {
+    n_transition_called++;
+    if (adapting())
+      n_adapting_called++;
+    return init_sample;
+  }
+
+  int n_transition_called;
+  int n_adapting_called;
+};
+
+struct mock_callback {
+  int n;
+  mock_callback() : n(0) { }
+
+  void operator()() {
+    n++;
+  }
+};
+
+TEST(StanServices, run_chains) {
+  const int num_chains = 3;
+
+  std::fstream empty_data_stream(std::string("").c_str());
+  stan::io::dump empty_data_context(empty_data_stream);
+  empty_data_stream.close();
+
+  std::stringstream model_output;
+  stan_model model(empty_data_context, &model_output);
+
+  std::vector<rng_t> rngs;
+  stan::services::mcmc::create_chain_rngs(123456, num_chains, rngs);
+
+  std::stringstream sample_output[num_chains];
+  std::stringstream diagnostic_output[num_chains];
+  std::stringstream message_output, error_output;
+  writer_t message_writer(message_output, "# ");
+  writer_t error_writer(error_output, "# ");
+
+  std::vector<writer_t*> writers;
+  std::vector<mcmc_writer_t*> mcmc_writers;
+  std::vector<mock_adaptive_sampler*> mock_samplers;
+  std::vector<stan::mcmc::base_mcmc*> samplers;
+  std::vector<stan::mcmc::sample> init_s;
+  for (int c = 0; c < num_chains; ++c) {
+    writers.push_back(new writer_t(sample_output[c], "# "));
+    writers.push_back(new writer_t(diagnostic_output[c], "# "));
+    mcmc_writers.push_back(new mcmc_writer_t(*writers[2 * c],
+                                             *writers[2 * c + 1],
+                                             message_writer));
+    mock_samplers.push_back(new mock_adaptive_sampler());
+    mock_samplers.back()->engage_adaptation();
+    samplers.push_back(mock_samplers.back());
+    init_s.push_back(stan::mcmc::sample(Eigen::VectorXd(0, 1), 0, 0));
+  }
+
+  int num_warmup = 30;
+  int num_samples = 50;
+  int num_thin = 2;
+  int refresh = 0;
+  std::stringstream ss;
+  mock_callback callback;
+  std::vector<double> warm_delta_t, sample_delta_t;
+
+  stan::services::mcmc::run_chains(samplers,
+                                   num_warmup, num_samples,
+                                   num_thin, refresh, false,
+                                   mcmc_writers, init_s, model, rngs,
+                                   "", "\n", ss,
+                                   callback,
+                                   message_writer,
+                                   error_writer,
+                                   warm_delta_t, sample_delta_t);
+
+  EXPECT_EQ(num_chains * (num_warmup + num_samples), callback.n);
+  ASSERT_EQ(num_chains, static_cast<int>(warm_delta_t.size()));
+  ASSERT_EQ(num_chains, static_cast<int>(sample_delta_t.size()));
+
+  for (int c = 0; c < num_chains; ++c) {
+    EXPECT_EQ(num_warmup + num_samples,
+              mock_samplers[c]->n_transition_called);
+    EXPECT_EQ(num_warmup, mock_samplers[c]->n_adapting_called);
+    EXPECT_FALSE(mock_samplers[c]->adapting());
+    EXPECT_GE(warm_delta_t[c], 0);
+    EXPECT_GE(sample_delta_t[c], 0);
+
+    std::string output = sample_output[c].str();
+    EXPECT_NE(std::string::npos, output.find("Adaptation terminated"));
+    EXPECT_NE(std::string::npos, output.find("Elapsed Time"));
+  }
+  EXPECT_EQ("", ss.str());
+  EXPECT_EQ("", error_output.str());
+
+  for (int c = 0; c < num_chains; ++c) {
+    delete mcmc_writers[c];
+    delete mock_samplers[c];
+  }
+  for (size_t n = 0; n < writers.size(); ++n)
+    delete writers[n];
+}
+
+TEST(StanServices, create_chain_rngs) {
+  std::vector<rng_t> rngs;
+  stan::services::mcmc::create_chain_rngs(123456, 3, rngs);
+  ASSERT_EQ(3U, rngs.size());
+
+  rng_t rng(123456);
+  EXPECT_EQ(rng(), rngs[0]());
+
+  EXPECT_NE(rngs[1](), rngs[2]());
+}
@@ -1,4 +1,6 @@
 #include <stan/services/mcmc/warmup.hpp>
+#include <stan/mcmc/stepsize_adaptation.hpp>
+#include <stan/mcmc/warmup_controller.hpp>
 #include <gtest/gtest.h>
 #include <test/test-models/good/services/test_lp.hpp>
 #include <stan/interface_callbacks/writer/base_writer.hpp>
@@ -132,3 +134,36 @@ TEST_F(StanServices, warmup) {
 }
 
 
+
+TEST_F(StanServices, warmup_early_stop) {
+  int num_warmup = 30;
+  int num_samples = 50;
+  int num_thin = 2;
+  int refresh = 0;
+  bool save = false;
+  stan::mcmc::sample s(q, log_prob, stat);
+  std::string prefix = "";
+  std::string suffix = "\n";
+  std::stringstream ss;
+  mock_callback callback;
+
+  // The mock sampler never moves the step size, so warmup ends at
+  // the minimum
+  stan::mcmc::stepsize_adaptation stepsize;
+  stan::mcmc::warmup_controller controller(stepsize, 0, 12, num_warmup);
+  controller.set_stepsize_window(5);
+
+  int n = stan::services::mcmc::warmup(sampler,
+                                       num_warmup, num_samples,
+                                       num_thin, refresh, save,
+                                       *writer, s, *model, base_rng,
+                                       prefix, suffix, ss,
+                                       callback,
+                                       message_writer,
+                                       error_writer,
+                                       0, &controller);
+
+  EXPECT_EQ(12, n);
+  EXPECT_EQ(12, sampler->n_transition_called);
+  EXPECT_EQ(12, callback.n);
+}
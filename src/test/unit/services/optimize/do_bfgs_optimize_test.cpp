@@ -1,11 +1,14 @@
 #include <gtest/gtest.h>
+#include <stan/interface_callbacks/interrupt/gradient_budget.hpp>
 #include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <stan/model/counting_model.hpp>
 #include <stan/services/optimize/do_bfgs_optimize.hpp>
 #include <stan/optimization/bfgs.hpp>
 #include <test/test-models/good/optimization/rosenbrock.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
 #include <boost/random/additive_combine.hpp>
 #include <test/unit/util.hpp>
+#include <algorithm>
 
 typedef rosenbrock_model_namespace::rosenbrock_model Model;
 typedef boost::ecuyer1988 rng_t; // (2**50 = 1T samples, 1000 chains)
@@ -94,3 +97,51 @@ TEST(Services, do_bfgs_optimize__lbfgs) {
   EXPECT_FLOAT_EQ(return_code, 0);
   EXPECT_EQ(35, callback.n);
 }
+
+TEST(Services, do_bfgs_optimize__bfgs_gradient_budget) {
+  typedef stan::model::counting_model<Model> counting_t;
+  typedef stan::optimization::BFGSLineSearch<counting_t,stan::optimization::BFGSUpdate_HInv<> > Optimizer_BFGS;
+
+  std::vector<double> cont_vector(2);
+  cont_vector[0] = -1; cont_vector[1] = 1;
+  std::vector<int> disc_vector;
+
+  static const std::string DATA("");
+  std::stringstream data_stream(DATA);
+  stan::io::dump dummy_context(data_stream);
+  Model model(dummy_context);
+  counting_t counting(model, 5);
+
+  std::stringstream out;
+  Optimizer_BFGS bfgs(counting, cont_vector, disc_vector, &out);
+  EXPECT_EQ("", out.str());
+
+  double lp = 0;
+  bool save_iterations = false;
+  int refresh = 0;
+  int return_code;
+  unsigned int random_seed = 0;
+  rng_t base_rng(random_seed);
+
+  stan::interface_callbacks::interrupt::gradient_budget<Model>
+    interrupt(counting);
+
+  stan::interface_callbacks::writer::stream_writer writer(out);
+  std::stringstream info_ss;
+  stan::interface_callbacks::writer::stream_writer info(info_ss);
+  return_code = stan::services::optimize::do_bfgs_optimize(counting, bfgs, base_rng,
+                                                           lp, cont_vector, disc_vector,
+                                                           writer, info,
+                                                           save_iterations, refresh,
+                                                           interrupt);
+  EXPECT_EQ(stan::services::error_codes::SOFTWARE, return_code);
+  EXPECT_TRUE(counting.budget_exhausted());
+  EXPECT_NE(std::string::npos,
+            info_ss.str().find("Optimization terminated with error: \n"
+                               "  Gradient evaluation budget exhausted"));
+  EXPECT_FLOAT_EQ(bfgs.logp(), lp);
+
+  // The last iterate is written once
+  std::string output = out.str();
+  EXPECT_EQ(1, std::count(output.begin(), output.end(), '\n'));
+}
@@ -0,0 +1,154 @@
+#include <stan/services/sample/chain_checkpoint.hpp>
+#include <stan/services/sample/generate_transitions.hpp>
+#include <stan/mcmc/hmc/nuts/adapt_diag_e_nuts.hpp>
+#include <stan/interface_callbacks/writer/base_writer.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <stan/io/dump.hpp>
+#include <test/test-models/good/mcmc/hmc/common/gauss3D.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+typedef boost::ecuyer1988 rng_t;
+typedef gauss3D_model_namespace::gauss3D_model model_t;
+typedef stan::mcmc::adapt_diag_e_nuts<model_t, rng_t> sampler_t;
+typedef stan::interface_callbacks::writer::stream_writer writer_t;
+
+class snapshot_writer
+  : public stan::interface_callbacks::writer::base_writer {
+public:
+  void operator()(const std::string& key, double value) {}
+  void operator()(const std::string& key, int value) {}
+  void operator()(const std::string& key, const std::string& value) {}
+  void operator()(const std::string& key, const double* values,
+                  int n_values) {}
+  void operator()(const std::string& key, const double* values,
+                  int n_rows, int n_cols) {}
+  void operator()(const std::vector<std::string>& names) {}
+  void operator()(const std::vector<double>& state) {}
+  void operator()() {}
+
+  void operator()(const std::string& message) {
+    snapshots.push_back(message);
+  }
+
+  std::vector<std::string> snapshots;
+};
+
+struct mock_callback {
+  void operator()() {}
+};
+
+class StanServicesChainCheckpoint : public testing::Test {
+public:
+  StanServicesChainCheckpoint()
+    : message_writer(message_output),
+      error_writer(error_output),
+      sample_writer(sample_output),
+      diagnostic_writer(diagnostic_output) {}
+
+  void SetUp() {
+    std::fstream empty_stream("", std::fstream::in);
+    stan::io::dump data_var_context(empty_stream);
+    model = new model_t(data_var_context);
+    mcmc_writer = new stan::services::sample::mcmc_writer<model_t, writer_t,
+                                                          writer_t, writer_t>
+      (sample_writer, diagnostic_writer, message_writer);
+  }
+
+  void TearDown() {
+    delete mcmc_writer;
+    delete model;
+  }
+
+  // Runs num_warmup warmup iterations from a fresh chain, resuming
+  // from the snapshot when one is given
+  void run(const std::string& snapshot, rng_t& rng,
+           snapshot_writer& snapshots, bool use_controller = false) {
+    sampler_t sampler(*model, rng);
+    sampler.engage_adaptation();
+    sampler.set_window_params(num_warmup, 10, 10, 10, message_writer);
+    sampler.get_stepsize_adaptation().set_mu(std::log(10 * 0.1));
+    sampler.get_stepsize_adaptation().set_delta(0.8);
+
+    Eigen::VectorXd q = Eigen::VectorXd::Ones(3);
+    stan::mcmc::sample s(q, 0, 0);
+    sampler.z().q = q;
+    sampler.init_stepsize(message_writer, error_writer);
+
+    stan::mcmc::warmup_controller controller(
+      sampler.get_stepsize_adaptation(), &sampler.get_var_adaptation(),
+      num_warmup, num_warmup);
+
+    stan::services::sample::chain_checkpoint checkpoint(20, snapshots);
+    if (!snapshot.empty())
+      checkpoint.resume_from(snapshot);
+
+    std::stringstream progress;
+    mock_callback callback;
+    stan::services::sample::generate_transitions
+      (&sampler, num_warmup, 0, num_warmup, 1, 0, false, true,
+       *mcmc_writer, s, *model, rng, "", "", progress, callback,
+       message_writer, error_writer, 0,
+       use_controller ? &controller : 0, &checkpoint);
+  }
+
+  static const int num_warmup = 60;
+
+  model_t* model;
+  stan::services::sample::mcmc_writer<model_t, writer_t,
+                                      writer_t, writer_t>* mcmc_writer;
+
+  std::stringstream message_output;
+  std::stringstream error_output;
+  std::stringstream sample_output;
+  std::stringstream diagnostic_output;
+  writer_t message_writer;
+  writer_t error_writer;
+  writer_t sample_writer;
+  writer_t diagnostic_writer;
+};
+
+TEST_F(StanServicesChainCheckpoint, resume_continues_exactly) {
+  rng_t rng(4839294);
+  snapshot_writer reference;
+  run("", rng, reference);
+  ASSERT_EQ(3U, reference.snapshots.size());
+
+  // A chain resumed from the second snapshot takes the same last
+  // 20 transitions, whatever the seed of its RNG
+  rng_t other_rng(1);
+  snapshot_writer resumed;
+  run(reference.snapshots[1], other_rng, resumed);
+  ASSERT_EQ(1U, resumed.snapshots.size());
+  EXPECT_EQ(reference.snapshots[2], resumed.snapshots[0]);
+
+  EXPECT_EQ("", error_output.str());
+}
+
+TEST_F(StanServicesChainCheckpoint, corrupt_snapshot) {
+  rng_t rng(4839294);
+  snapshot_writer snapshots;
+  EXPECT_THROW(run("stan_chain_state 1 1 20", rng, snapshots),
+               std::domain_error);
+}
+
+TEST_F(StanServicesChainCheckpoint, controller_mismatch) {
+  rng_t rng(4839294);
+  snapshot_writer without_controller;
+  run("", rng, without_controller);
+  snapshot_writer with_controller;
+  run("", rng, with_controller, true);
+  ASSERT_EQ(3U, with_controller.snapshots.size());
+
+  // Warmup snapshots only resume with the same warmup configuration
+  snapshot_writer snapshots;
+  EXPECT_THROW(run(without_controller.snapshots[1], rng, snapshots, true),
+               std::domain_error);
+  EXPECT_THROW(run(with_controller.snapshots[1], rng, snapshots),
+               std::domain_error);
+  EXPECT_NO_THROW(run(with_controller.snapshots[1], rng, snapshots, true));
+}
@@ -34,6 +34,20 @@ struct mock_callback {
   }
 };
 
+// Throws once the budget of callbacks is used up, as the
+// gradient_budget interrupt does
+struct budget_callback {
+  int n;
+  int budget;
+  explicit budget_callback(int b) : n(0), budget(b) { }
+
+  void operator()() {
+    if (n == budget)
+      throw stan::model::gradient_budget_exhausted(budget);
+    n++;
+  }
+};
+
 class StanServices : public testing::Test {
 public:
   StanServices()
@@ -135,3 +149,74 @@ TEST_F(StanServices, generate_transitions) {
   EXPECT_EQ("", error_output.str());
 }
 
+
+TEST_F(StanServices, generate_transitions_profile) {
+  int num_iterations = 10;
+  int num_thin = 2;
+  stan::mcmc::sample s(q, log_prob, stat);
+  std::stringstream ss;
+  mock_callback callback;
+
+  std::stringstream trace_output;
+  stan::interface_callbacks::writer::stream_writer trace_writer(trace_output);
+  stan::mcmc::transition_profile profile;
+  profile.set_trace_writer(&trace_writer);
+
+  // Draws are saved, so the writers must outlive the mcmc_writer
+  writer_t sample_writer(sample_output, "# ");
+  writer_t diagnostic_writer(diagnostic_output, "# ");
+  stan::services::sample::mcmc_writer<stan_model, writer_t, writer_t,
+                                      writer_t>
+    saving_writer(sample_writer, diagnostic_writer, message_writer);
+
+  stan::services::sample::generate_transitions(sampler,
+                                               num_iterations, 0,
+                                               num_iterations,
+                                               num_thin, 0, true, false,
+                                               saving_writer, s, *model,
+                                               base_rng,
+                                               "", "\n", ss,
+                                               callback,
+                                               message_writer,
+                                               error_writer,
+                                               &profile);
+
+  typedef stan::mcmc::transition_profile profile_t;
+  EXPECT_EQ(num_iterations, sampler->n_transition_called);
+  EXPECT_EQ(num_iterations, profile.num_iterations());
+  EXPECT_EQ(num_iterations, profile.total_calls(profile_t::transition_phase));
+  EXPECT_EQ(num_iterations / num_thin,
+            profile.total_calls(profile_t::output_phase));
+  EXPECT_EQ(num_iterations / num_thin,
+            profile.total_calls(profile_t::write_array_phase));
+  EXPECT_EQ(0, profile.total_calls(profile_t::gradient_phase));
+
+  // Header plus one line per iteration
+  std::string trace = trace_output.str();
+  EXPECT_EQ(num_iterations + 1, std::count(trace.begin(), trace.end(), '\n'));
+  EXPECT_EQ(0U, trace.find("iteration,transition_calls,transition_seconds"));
+
+  EXPECT_EQ("", error_output.str());
+}
+
+TEST_F(StanServices, generate_transitions_gradient_budget) {
+  stan::mcmc::sample s(q, log_prob, stat);
+  std::stringstream ss;
+  budget_callback callback(4);
+
+  int m = stan::services::sample::generate_transitions(sampler,
+                                                       10, 0, 10,
+                                                       1, 0, false, false,
+                                                       *writer, s, *model,
+                                                       base_rng,
+                                                       "", "\n", ss,
+                                                       callback,
+                                                       message_writer,
+                                                       error_writer);
+
+  EXPECT_EQ(4, m);
+  EXPECT_EQ(4, sampler->n_transition_called);
+  EXPECT_EQ("# Gradient evaluation budget exhausted after 4 gradient "
+            "evaluations\n", message_output.str());
+  EXPECT_EQ("", error_output.str());
+}
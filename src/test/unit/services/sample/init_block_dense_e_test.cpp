@@ -0,0 +1,89 @@
+#include <stan/services/sample/init_block_dense_e.hpp>
+#include <stan/services/sample/init_metric.hpp>
+#include <stan/services/arguments/arg_sample_algo.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class mock_block_sampler : public stan::mcmc::base_mcmc,
+                           public stan::mcmc::stepsize_block_covar_adapter {
+public:
+  mock_block_sampler() : stepsize_block_covar_adapter(3), z_(3) {}
+
+  stan::mcmc::sample
+  transition(stan::mcmc::sample& init_sample,
+             stan::interface_callbacks::writer::base_writer& info_writer,
+             stan::interface_callbacks::writer::base_writer& error_writer) {
+    return init_sample;
+  }
+
+  stan::mcmc::block_dense_e_point& z() {
+    return z_;
+  }
+
+  stan::mcmc::block_dense_e_point z_;
+};
+
+struct mock_model {
+  void unconstrained_param_names(std::vector<std::string>& names,
+                                 bool include_tparams,
+                                 bool include_gqs) const {
+    names.push_back("beta.1");
+    names.push_back("beta.2");
+    names.push_back("sigma");
+  }
+};
+
+void select_block_dense_e(stan::services::arg_sample_algo& algorithm) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+  std::vector<std::string> args(1, "metric=block_dense_e");
+  bool help_flag = false;
+  dynamic_cast<stan::services::list_argument*>
+    (algorithm.arg("hmc")->arg("metric"))
+    ->parse_args(args, writer, writer, help_flag);
+}
+
+TEST(ServicesSample, init_block_dense_e_from_names) {
+  stan::services::arg_sample_algo algorithm;
+  mock_block_sampler sampler;
+  mock_model model;
+
+  // Only the selected metric is read
+  EXPECT_FALSE(stan::services::sample::init_block_dense_e
+               <mock_block_sampler>(&sampler, &algorithm, model));
+  EXPECT_EQ(3U, sampler.z().block_sizes.size());
+
+  select_block_dense_e(algorithm);
+  EXPECT_TRUE(stan::services::sample::init_block_dense_e
+              <mock_block_sampler>(&sampler, &algorithm, model));
+
+  ASSERT_EQ(2U, sampler.z().block_sizes.size());
+  EXPECT_EQ(2, sampler.z().block_sizes[0]);
+  EXPECT_EQ(1, sampler.z().block_sizes[1]);
+  ASSERT_EQ(2U, sampler.z().mInv.size());
+  EXPECT_EQ(2, sampler.z().mInv[0].rows());
+  EXPECT_EQ(sampler.z().block_sizes,
+            sampler.get_block_covar_adaptation().block_sizes());
+}
+
+TEST(ServicesSample, init_metric_block_dense_e) {
+  stan::services::arg_sample_algo algorithm;
+  mock_block_sampler sampler;
+  mock_model model;
+
+  select_block_dense_e(algorithm);
+  dynamic_cast<stan::services::string_argument*>
+    (algorithm.arg("hmc")->arg("metric")->arg("block_dense_e")
+     ->arg("blocks"))->set_value("1,2");
+  EXPECT_TRUE(stan::services::sample::init_metric<mock_block_sampler>
+              (&sampler, &algorithm, model));
+
+  ASSERT_EQ(2U, sampler.z().block_sizes.size());
+  EXPECT_EQ(1, sampler.z().block_sizes[0]);
+  EXPECT_EQ(2, sampler.z().block_sizes[1]);
+  EXPECT_EQ(sampler.z().block_sizes,
+            sampler.get_block_covar_adaptation().block_sizes());
+}
@@ -0,0 +1,74 @@
+#include <stan/services/sample/init_lowrank_diag_e.hpp>
+#include <stan/services/sample/init_metric.hpp>
+#include <stan/services/arguments/arg_sample_algo.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class mock_lowrank_sampler : public stan::mcmc::base_mcmc,
+                             public stan::mcmc::stepsize_lowrank_var_adapter {
+public:
+  mock_lowrank_sampler() : stepsize_lowrank_var_adapter(3), z_(3) {}
+
+  stan::mcmc::sample
+  transition(stan::mcmc::sample& init_sample,
+             stan::interface_callbacks::writer::base_writer& info_writer,
+             stan::interface_callbacks::writer::base_writer& error_writer) {
+    return init_sample;
+  }
+
+  stan::mcmc::lowrank_diag_e_point& z() {
+    return z_;
+  }
+
+  stan::mcmc::lowrank_diag_e_point z_;
+};
+
+struct mock_model {
+};
+
+void select_metric(stan::services::arg_sample_algo& algorithm,
+                   const std::string& metric) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+  std::vector<std::string> args(1, "metric=" + metric);
+  bool help_flag = false;
+  dynamic_cast<stan::services::list_argument*>
+    (algorithm.arg("hmc")->arg("metric"))
+    ->parse_args(args, writer, writer, help_flag);
+}
+
+TEST(ServicesSample, init_lowrank_diag_e_rank) {
+  stan::services::arg_sample_algo algorithm;
+  mock_lowrank_sampler sampler;
+  int rank = sampler.get_lowrank_var_adaptation().rank();
+
+  // Only the selected metric is read
+  EXPECT_FALSE(stan::services::sample::init_lowrank_diag_e
+               <mock_lowrank_sampler>(&sampler, &algorithm));
+  EXPECT_EQ(rank, sampler.get_lowrank_var_adaptation().rank());
+
+  select_metric(algorithm, "lowrank_diag_e");
+  dynamic_cast<stan::services::int_argument*>
+    (algorithm.arg("hmc")->arg("metric")->arg("lowrank_diag_e")
+     ->arg("rank"))->set_value(2);
+  EXPECT_TRUE(stan::services::sample::init_lowrank_diag_e
+              <mock_lowrank_sampler>(&sampler, &algorithm));
+  EXPECT_EQ(2, sampler.get_lowrank_var_adaptation().rank());
+}
+
+TEST(ServicesSample, init_metric_lowrank_diag_e) {
+  stan::services::arg_sample_algo algorithm;
+  mock_lowrank_sampler sampler;
+  mock_model model;
+
+  select_metric(algorithm, "lowrank_diag_e");
+  dynamic_cast<stan::services::int_argument*>
+    (algorithm.arg("hmc")->arg("metric")->arg("lowrank_diag_e")
+     ->arg("rank"))->set_value(1);
+  EXPECT_TRUE(stan::services::sample::init_metric<mock_lowrank_sampler>
+              (&sampler, &algorithm, model));
+  EXPECT_EQ(1, sampler.get_lowrank_var_adaptation().rank());
+}
@@ -0,0 +1,121 @@
+#include <stan/services/sample/init_lowrank_softabs.hpp>
+#include <stan/services/sample/init_metric.hpp>
+#include <stan/services/sample/init_softabs.hpp>
+#include <stan/services/arguments/arg_sample_algo.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+template <class Point>
+class mock_riemannian_sampler : public stan::mcmc::base_mcmc {
+public:
+  mock_riemannian_sampler() : z_(3) {}
+
+  stan::mcmc::sample
+  transition(stan::mcmc::sample& init_sample,
+             stan::interface_callbacks::writer::base_writer& info_writer,
+             stan::interface_callbacks::writer::base_writer& error_writer) {
+    return init_sample;
+  }
+
+  Point& z() {
+    return z_;
+  }
+
+  Point z_;
+};
+
+typedef mock_riemannian_sampler<stan::mcmc::softabs_point> softabs_sampler;
+typedef mock_riemannian_sampler<stan::mcmc::lowrank_softabs_point>
+lowrank_softabs_sampler;
+
+struct mock_model {
+};
+
+stan::services::argument*
+select_softabs_metric(stan::services::arg_sample_algo& algorithm,
+                      const std::string& metric) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+  std::vector<std::string> args(1, "metric=" + metric);
+  bool help_flag = false;
+  dynamic_cast<stan::services::list_argument*>
+    (algorithm.arg("hmc")->arg("metric"))
+    ->parse_args(args, writer, writer, help_flag);
+  return algorithm.arg("hmc")->arg("metric")->arg(metric);
+}
+
+TEST(ServicesSample, init_lowrank_softabs) {
+  stan::services::arg_sample_algo algorithm;
+  lowrank_softabs_sampler sampler;
+
+  // Only the selected metric is read
+  EXPECT_FALSE(stan::services::sample::init_lowrank_softabs
+               <lowrank_softabs_sampler>(&sampler, &algorithm));
+
+  stan::services::argument* metric
+    = select_softabs_metric(algorithm, "lowrank_softabs");
+  ASSERT_TRUE(metric != 0);
+  dynamic_cast<stan::services::real_argument*>(metric->arg("alpha"))
+    ->set_value(2.5);
+  dynamic_cast<stan::services::int_argument*>(metric->arg("rank"))
+    ->set_value(2);
+  dynamic_cast<stan::services::real_argument*>(metric->arg("tol"))
+    ->set_value(1e-6);
+  dynamic_cast<stan::services::int_argument*>(metric->arg("max_resolvent"))
+    ->set_value(7);
+
+  EXPECT_TRUE(stan::services::sample::init_lowrank_softabs
+              <lowrank_softabs_sampler>(&sampler, &algorithm));
+  EXPECT_FLOAT_EQ(2.5, sampler.z().alpha);
+  EXPECT_EQ(2, sampler.z().rank);
+  EXPECT_FLOAT_EQ(1e-6, sampler.z().tol);
+  EXPECT_EQ(7, sampler.z().max_num_resolvent);
+}
+
+TEST(ServicesSample, init_softabs) {
+  stan::services::arg_sample_algo algorithm;
+  softabs_sampler sampler;
+
+  EXPECT_FALSE(stan::services::sample::init_softabs<softabs_sampler>
+               (&sampler, &algorithm));
+
+  stan::services::argument* metric
+    = select_softabs_metric(algorithm, "softabs");
+  ASSERT_TRUE(metric != 0);
+  dynamic_cast<stan::services::real_argument*>(metric->arg("alpha"))
+    ->set_value(3);
+
+  EXPECT_TRUE(stan::services::sample::init_softabs<softabs_sampler>
+              (&sampler, &algorithm));
+  EXPECT_FLOAT_EQ(3, sampler.z().alpha);
+}
+
+TEST(ServicesSample, init_metric_softabs) {
+  stan::services::arg_sample_algo algorithm;
+  mock_model model;
+
+  stan::services::argument* metric
+    = select_softabs_metric(algorithm, "softabs");
+  dynamic_cast<stan::services::real_argument*>(metric->arg("alpha"))
+    ->set_value(4);
+  softabs_sampler sampler;
+  EXPECT_TRUE(stan::services::sample::init_metric<softabs_sampler>
+              (&sampler, &algorithm, model));
+  EXPECT_FLOAT_EQ(4, sampler.z().alpha);
+
+  // The low-rank sampler does not take the softabs options
+  lowrank_softabs_sampler lowrank_sampler;
+  EXPECT_FALSE(stan::services::sample::init_metric<lowrank_softabs_sampler>
+               (&lowrank_sampler, &algorithm, model));
+  EXPECT_FLOAT_EQ(1, lowrank_sampler.z().alpha);
+
+  metric = select_softabs_metric(algorithm, "lowrank_softabs");
+  dynamic_cast<stan::services::int_argument*>(metric->arg("rank"))
+    ->set_value(1);
+  EXPECT_TRUE(stan::services::sample::init_metric<lowrank_softabs_sampler>
+              (&lowrank_sampler, &algorithm, model));
+  EXPECT_EQ(1, lowrank_sampler.z().rank);
+}
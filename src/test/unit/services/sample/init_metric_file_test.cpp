@@ -0,0 +1,90 @@
+#include <stan/services/sample/init_metric_file.hpp>
+#include <stan/services/arguments/arg_sample_algo.hpp>
+#include <stan/mcmc/hmc/nuts/diag_e_nuts.hpp>
+#include <stan/interface_callbacks/writer/dump_writer.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <stan/io/dump.hpp>
+#include <test/test-models/good/mcmc/hmc/common/gauss3D.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+typedef boost::ecuyer1988 rng_t;
+typedef gauss3D_model_namespace::gauss3D_model model_t;
+typedef stan::mcmc::diag_e_nuts<model_t, rng_t> sampler_t;
+
+class StanServicesInitMetricFile : public testing::Test {
+public:
+  StanServicesInitMetricFile()
+    : path("init_metric_file_test.data"),
+      error_writer(error_output) {}
+
+  void SetUp() {
+    std::fstream empty_stream("", std::fstream::in);
+    stan::io::dump data_var_context(empty_stream);
+    model = new model_t(data_var_context);
+  }
+
+  void TearDown() {
+    delete model;
+    std::remove(path.c_str());
+  }
+
+  void set_metric_file(const std::string& file) {
+    dynamic_cast<stan::services::string_argument*>
+      (algorithm.arg("hmc")->arg("metric_file"))->set_value(file);
+  }
+
+  std::string path;
+  model_t* model;
+  stan::services::arg_sample_algo algorithm;
+  std::stringstream error_output;
+  stan::interface_callbacks::writer::stream_writer error_writer;
+};
+
+TEST_F(StanServicesInitMetricFile, no_file) {
+  rng_t rng(0);
+  sampler_t sampler(*model, rng);
+  sampler.set_nominal_stepsize(0.5);
+
+  EXPECT_TRUE(stan::services::sample::init_metric_file<sampler_t>
+              (&sampler, &algorithm, error_writer));
+  EXPECT_EQ(0.5, sampler.get_nominal_stepsize());
+  EXPECT_EQ("", error_output.str());
+}
+
+TEST_F(StanServicesInitMetricFile, round_trip) {
+  rng_t rng(0);
+  sampler_t adapted(*model, rng);
+  adapted.set_nominal_stepsize(0.37);
+  adapted.z().mInv << 0.5, 2, 1.0 / 3.0;
+
+  {
+    std::ofstream file(path.c_str());
+    stan::interface_callbacks::writer::dump_writer dump_writer(file);
+    adapted.write_adapted_params(dump_writer);
+  }
+
+  sampler_t sampler(*model, rng);
+  set_metric_file(path);
+  EXPECT_TRUE(stan::services::sample::init_metric_file<sampler_t>
+              (&sampler, &algorithm, error_writer));
+
+  EXPECT_EQ(0.37, sampler.get_nominal_stepsize());
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(adapted.z().mInv(i), sampler.z().mInv(i));
+  EXPECT_EQ("", error_output.str());
+}
+
+TEST_F(StanServicesInitMetricFile, missing_file) {
+  rng_t rng(0);
+  sampler_t sampler(*model, rng);
+
+  set_metric_file("no_such_metric_file.data");
+  EXPECT_FALSE(stan::services::sample::init_metric_file<sampler_t>
+               (&sampler, &algorithm, error_writer));
+  EXPECT_NE("", error_output.str());
+}
@@ -0,0 +1,33 @@
+#include <stan/services/sample/init_warmup_controller.hpp>
+#include <stan/services/arguments/arg_adapt.hpp>
+#include <gtest/gtest.h>
+
+TEST(ServicesSample, init_warmup_controller) {
+  stan::services::arg_adapt adapt;
+  stan::mcmc::stepsize_adaptation stepsize;
+  stepsize.set_mu(0.5);
+  stepsize.set_delta(0.8);
+
+  stan::mcmc::warmup_controller controller(stepsize, 0, 0, 100);
+  controller.set_stepsize_window(5);
+
+  // Early termination is off by default
+  EXPECT_FALSE(stan::services::sample::init_warmup_controller(controller,
+                                                              &adapt));
+
+  dynamic_cast<stan::services::bool_argument*>(adapt.arg("early_stop"))
+    ->set_value(true);
+  dynamic_cast<stan::services::u_int_argument*>(adapt.arg("min_warmup"))
+    ->set_value(20);
+  EXPECT_TRUE(stan::services::sample::init_warmup_controller(controller,
+                                                             &adapt));
+
+  // A stable step size ends warmup only after min_warmup iterations
+  double epsilon = 1;
+  for (int i = 1; i < 20; ++i) {
+    stepsize.learn_stepsize(epsilon, 0.8);
+    EXPECT_FALSE(controller.update());
+  }
+  stepsize.learn_stepsize(epsilon, 0.8);
+  EXPECT_TRUE(controller.update());
+}
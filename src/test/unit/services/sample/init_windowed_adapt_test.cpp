@@ -1,3 +1,84 @@
 #include <stan/services/sample/init_windowed_adapt.hpp>
+#include <stan/services/arguments/arg_adapt.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
 #include <gtest/gtest.h>
-// FIXME: needs tests
+#include <sstream>
+
+struct mock_point {
+  Eigen::VectorXd q;
+};
+
+class mock_dense_sampler : public stan::mcmc::base_mcmc,
+                           public stan::mcmc::stepsize_covar_adapter {
+public:
+  mock_dense_sampler() : stepsize_covar_adapter(2) {}
+
+  stan::mcmc::sample
+  transition(stan::mcmc::sample& init_sample,
+             stan::interface_callbacks::writer::base_writer& info_writer,
+             stan::interface_callbacks::writer::base_writer& error_writer) {
+    return init_sample;
+  }
+
+  double get_nominal_stepsize() {
+    return 1;
+  }
+
+  mock_point& z() {
+    return z_;
+  }
+
+  void init_stepsize(
+    stan::interface_callbacks::writer::base_writer& info_writer,
+    stan::interface_callbacks::writer::base_writer& error_writer) {}
+
+  mock_point z_;
+};
+
+TEST(ServicesSample, init_windowed_adapt_streaming) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+  Eigen::VectorXd cont_params = Eigen::VectorXd::Zero(2);
+
+  stan::services::arg_adapt adapt;
+  mock_dense_sampler sampler;
+
+  EXPECT_TRUE(stan::services::sample::init_windowed_adapt<mock_dense_sampler>
+              (&sampler, &adapt, 1000, cont_params, writer, writer));
+  EXPECT_FALSE(sampler.get_covar_adaptation().streaming());
+
+  dynamic_cast<stan::services::bool_argument*>(adapt.arg("streaming"))
+    ->set_value(true);
+  EXPECT_TRUE(stan::services::sample::init_windowed_adapt<mock_dense_sampler>
+              (&sampler, &adapt, 1000, cont_params, writer, writer));
+  EXPECT_TRUE(sampler.get_covar_adaptation().streaming());
+
+  EXPECT_EQ("", ss.str());
+}
+
+TEST(ServicesSample, init_windowed_adapt_early_stop) {
+  std::stringstream ss;
+  stan::interface_callbacks::writer::stream_writer writer(ss);
+  Eigen::VectorXd cont_params = Eigen::VectorXd::Zero(2);
+
+  stan::services::arg_adapt adapt;
+  mock_dense_sampler sampler;
+  stan::mcmc::warmup_controller
+    controller(sampler.get_stepsize_adaptation(),
+               &sampler.get_covar_adaptation(), 0, 1000);
+
+  bool early_stop = true;
+  EXPECT_TRUE(stan::services::sample::init_windowed_adapt<mock_dense_sampler>
+              (&sampler, &adapt, 1000, cont_params, controller, early_stop,
+               writer, writer));
+  EXPECT_FALSE(early_stop);
+
+  dynamic_cast<stan::services::bool_argument*>(adapt.arg("early_stop"))
+    ->set_value(true);
+  EXPECT_TRUE(stan::services::sample::init_windowed_adapt<mock_dense_sampler>
+              (&sampler, &adapt, 1000, cont_params, controller, early_stop,
+               writer, writer));
+  EXPECT_TRUE(early_stop);
+
+  EXPECT_EQ("", ss.str());
+}
@@ -0,0 +1,114 @@
+#include <stan/services/sample/load_adapted_params.hpp>
+#include <stan/services/sample/mcmc_writer.hpp>
+#include <stan/mcmc/hmc/nuts/diag_e_nuts.hpp>
+#include <stan/mcmc/hmc/nuts/dense_e_nuts.hpp>
+#include <stan/interface_callbacks/writer/dump_writer.hpp>
+#include <stan/interface_callbacks/writer/stream_writer.hpp>
+#include <stan/io/dump.hpp>
+#include <test/test-models/good/mcmc/hmc/common/gauss3D.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+
+typedef boost::ecuyer1988 rng_t;
+typedef gauss3D_model_namespace::gauss3D_model model_t;
+
+class StanServicesLoadAdaptedParams : public testing::Test {
+public:
+  StanServicesLoadAdaptedParams()
+    : error_writer(error_output) {}
+
+  void SetUp() {
+    std::fstream empty_stream("", std::fstream::in);
+    stan::io::dump data_var_context(empty_stream);
+    model = new model_t(data_var_context);
+  }
+
+  void TearDown() {
+    delete model;
+  }
+
+  model_t* model;
+  std::stringstream error_output;
+  stan::interface_callbacks::writer::stream_writer error_writer;
+};
+
+TEST_F(StanServicesLoadAdaptedParams, diag_e_round_trip) {
+  rng_t rng(0);
+  stan::mcmc::diag_e_nuts<model_t, rng_t> adapted(*model, rng);
+  adapted.set_nominal_stepsize(0.37);
+  adapted.z().mInv << 0.5, 2, 1.0 / 3.0;
+
+  std::stringstream adapted_output;
+  stan::interface_callbacks::writer::dump_writer dump_writer(adapted_output);
+  adapted.write_adapted_params(dump_writer);
+
+  stan::io::dump context(adapted_output);
+  stan::mcmc::diag_e_nuts<model_t, rng_t> sampler(*model, rng);
+  EXPECT_TRUE(stan::services::sample::load_adapted_params<
+              stan::mcmc::diag_e_nuts<model_t, rng_t> >
+              (&sampler, context, error_writer));
+
+  EXPECT_EQ(0.37, sampler.get_nominal_stepsize());
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(adapted.z().mInv(i), sampler.z().mInv(i));
+  EXPECT_EQ("", error_output.str());
+}
+
+TEST_F(StanServicesLoadAdaptedParams, dense_e_round_trip) {
+  rng_t rng(0);
+  stan::mcmc::dense_e_nuts<model_t, rng_t> adapted(*model, rng);
+  adapted.set_nominal_stepsize(0.37);
+  adapted.z().mInv << 2, 0.5, 0,
+                      0.5, 1, 0.1,
+                      0, 0.1, 3;
+  adapted.z().update_mInv_factor();
+
+  std::stringstream adapted_output;
+  stan::interface_callbacks::writer::dump_writer dump_writer(adapted_output);
+  adapted.write_adapted_params(dump_writer);
+
+  stan::io::dump context(adapted_output);
+  stan::mcmc::dense_e_nuts<model_t, rng_t> sampler(*model, rng);
+  EXPECT_TRUE(stan::services::sample::load_adapted_params<
+              stan::mcmc::dense_e_nuts<model_t, rng_t> >
+              (&sampler, context, error_writer));
+
+  EXPECT_EQ(0.37, sampler.get_nominal_stepsize());
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(adapted.z().mInv(i, j), sampler.z().mInv(i, j));
+      EXPECT_FLOAT_EQ(adapted.z().mInv_L(i, j), sampler.z().mInv_L(i, j));
+    }
+  }
+  EXPECT_EQ("", error_output.str());
+}
+
+TEST_F(StanServicesLoadAdaptedParams, wrong_size) {
+  std::stringstream adapted_output;
+  adapted_output << "stepsize <- 0.5\ninv_metric <- c(1, 2)\n";
+  stan::io::dump context(adapted_output);
+
+  rng_t rng(0);
+  stan::mcmc::diag_e_nuts<model_t, rng_t> sampler(*model, rng);
+  EXPECT_FALSE(stan::services::sample::load_adapted_params<
+               stan::mcmc::diag_e_nuts<model_t, rng_t> >
+               (&sampler, context, error_writer));
+  EXPECT_EQ(1, sampler.z().mInv(0));
+  EXPECT_NE("", error_output.str());
+}
+
+TEST_F(StanServicesLoadAdaptedParams, not_positive_definite) {
+  std::stringstream adapted_output;
+  adapted_output << "inv_metric <- structure(c(1, 2, 0, 2, 1, 0, 0, 0, 1), "
+                 << ".Dim = c(3, 3))\n";
+  stan::io::dump context(adapted_output);
+
+  rng_t rng(0);
+  stan::mcmc::dense_e_nuts<model_t, rng_t> sampler(*model, rng);
+  EXPECT_FALSE(stan::services::sample::load_adapted_params<
+               stan::mcmc::dense_e_nuts<model_t, rng_t> >
+               (&sampler, context, error_writer));
+  EXPECT_NE("", error_output.str());
+}